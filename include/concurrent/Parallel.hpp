@@ -0,0 +1,89 @@
+/*
+ * @file  include/concurrent/Parallel.hpp
+ * @brief 把数据并行的循环与排序分给多个 std::thread
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace BR {
+namespace detail {
+
+/*
+ *  把 [0, n) 切成至多 threads 段，在各自的线程中调用 fn( begin, end )；threads <= 1 时在当前线程执行
+ */
+template< class Fn >
+void parallel_for( int n, int threads, Fn fn ) {
+	if ( threads <= 1 || n < 2 ) {
+		fn( 0, n );
+		return;
+	}
+	if ( threads > n ) {
+		threads = n;
+	}
+	std::vector< std::thread > workers;
+	for( int t=1; t<threads; ++t ) {
+		workers.push_back( std::thread( fn, (int)( (long long)n * t / threads ), (int)( (long long)n * ( t + 1 ) / threads ) ) );
+	}
+	fn( 0, (int)( (long long)n / threads ) );
+	for( size_t t=0; t<workers.size(); ++t ) {
+		workers[t].join();
+	}
+}
+
+/*
+ *  各段并行排序后逐轮两两并行归并
+ */
+template< class Iter, class Less >
+void parallel_sort( Iter first, Iter last, Less less, int threads ) {
+	int n = (int)( last - first );
+	if ( threads <= 1 || n < 4096 ) {
+		std::sort( first, last, less );
+		return;
+	}
+	std::vector< int > bounds;
+	for( int t=0; t<=threads; ++t ) {
+		bounds.push_back( (int)( (long long)n * t / threads ) );
+	}
+	parallel_for( threads, threads, [&]( int begin, int end ) {
+		for( int t=begin; t<end; ++t ) {
+			std::sort( first + bounds[t], first + bounds[t+1], less );
+		}
+	} );
+	for( int width=1; width<threads; width*=2 ) {
+		int pairs = ( threads + 2*width - 1 ) / ( 2*width );
+		parallel_for( pairs, pairs, [&]( int begin, int end ) {
+			for( int p=begin; p<end; ++p ) {
+				int lo = p * 2 * width;
+				int mid = std::min( lo + width, threads );
+				int hi = std::min( lo + 2 * width, threads );
+				if ( mid < hi ) {
+					std::inplace_merge( first + bounds[lo], first + bounds[mid], first + bounds[hi], less );
+				}
+			}
+		} );
+	}
+}
+
+inline int default_threads( int threads ) {
+	if ( threads > 0 ) {
+		return threads;
+	}
+	int hw = (int)std::thread::hardware_concurrency();
+	return hw > 0 ? hw : 1;
+}
+
+/*
+ *  每个线程至少分到 grain 项工作时实际使用的线程数
+ */
+inline int work_threads( int threads, int n, int grain ) {
+	return std::max( 1, std::min( default_threads( threads ), n / grain ) );
+}
+
+} // namespace detail
+
+}
@@ -7,6 +7,7 @@
 #include <boost/config.hpp>
 
 #ifndef NDEBUG
+#	include <cassert>
 #	define BR_ASSERT          assert
 #else
 #	define BR_ASSERT( x )     { }
@@ -70,6 +71,18 @@
 
 #define BR_GET_SIZE( Tp, n ) sizeof(Tp) * (n)
 
+#if defined(__unix__) || defined(__APPLE__)
+#	define BR_HAS_MMAP
+#endif
+
+#if defined(__linux__)
+#	define BR_HAS_MREMAP
+#endif
+
+#ifndef BR_CACHE_LINE_SIZE
+#	define BR_CACHE_LINE_SIZE 64
+#endif // BR_CACHE_LINE_SIZE
+
 #define BR_SELFTYPE_SERIES( type_name ) \
 typedef type_name       SelfType;       \
 typedef SelfType const  CSelfType;      \
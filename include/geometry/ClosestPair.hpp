@@ -0,0 +1,143 @@
+/*
+ * @file  include/geometry/ClosestPair.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <concurrent/Parallel.hpp>
+
+namespace BR {
+
+/*
+ *  最近点对在输入数组中的下标与距离平方；点数少于 2 时下标为 -1，距离为无穷大
+ */
+struct ClosestPairResult {
+	int    first;
+	int    second;
+	double dist_sqr;
+};
+
+namespace detail {
+
+class ClosestPairSolver {
+public:
+	struct Item {
+		double x, y;
+		int    id;
+	};
+
+	struct LessX {
+		bool operator()( Item const & lhs, Item const & rhs ) const {
+			return lhs.x < rhs.x;
+		}
+	};
+
+	/*
+	 *  items 已按 x 排序，返回时按 y 排序；tmp 与 items 等长，左右两半互不相交，可以并行
+	 */
+	static void solve( Item * items, Item * tmp, int n, int depth, ClosestPairResult & best ) {
+		if ( n <= 3 ) {
+			for( int i=0; i<n; ++i ) {
+				for( int j=i+1; j<n; ++j ) {
+					update( items[i], items[j], best );
+				}
+			}
+			std::sort( items, items + n, LessY() );
+			return;
+		}
+
+		int mid = n / 2;
+		double mid_x = items[mid].x;
+		if ( depth > 0 ) {
+			ClosestPairResult left = best;
+			std::thread worker( solve, items, tmp, mid, depth - 1, std::ref( left ) );
+			solve( items + mid, tmp + mid, n - mid, depth - 1, best );
+			worker.join();
+			if ( left.dist_sqr < best.dist_sqr ) {
+				best = left;
+			}
+		} else {
+			solve( items, tmp, mid, 0, best );
+			solve( items + mid, tmp + mid, n - mid, 0, best );
+		}
+
+		std::merge( items, items + mid, items + mid, items + n, tmp, LessY() );
+		std::copy( tmp, tmp + n, items );
+
+		// 只有离分界线不超过当前最短距离的点可能组成更近的点对，按 y 排序后每个点只需与其后少数几个点比较
+		int strip = 0;
+		for( int i=0; i<n; ++i ) {
+			double dx = items[i].x - mid_x;
+			if ( dx * dx < best.dist_sqr ) {
+				tmp[strip++] = items[i];
+			}
+		}
+		for( int i=0; i<strip; ++i ) {
+			for( int j=i+1; j<strip; ++j ) {
+				double dy = tmp[j].y - tmp[i].y;
+				if ( dy * dy >= best.dist_sqr ) {
+					break;
+				}
+				update( tmp[i], tmp[j], best );
+			}
+		}
+	}
+
+private:
+	struct LessY {
+		bool operator()( Item const & lhs, Item const & rhs ) const {
+			return lhs.y < rhs.y;
+		}
+	};
+
+	static void update( Item const & a, Item const & b, ClosestPairResult & best ) {
+		double dx = a.x - b.x, dy = a.y - b.y;
+		double d = dx * dx + dy * dy;
+		if ( d < best.dist_sqr ) {
+			best.first = std::min( a.id, b.id );
+			best.second = std::max( a.id, b.id );
+			best.dist_sqr = d;
+		}
+	}
+};
+
+} // namespace detail
+
+/*
+ *  @brief 分治法求最近点对，O(n log n)
+ *  @param  Point  带 x、y 成员的点类型，如 Point2D<double>
+ *
+ *  坐标按 double 计算距离。递归的前 log2(threads) 层把左半边交给新线程，
+ *  各线程在 tmp 的不同区间上归并，彼此不共享可写数据。
+ */
+template< class Point >
+ClosestPairResult closest_pair( Point const * pts, int n, int threads = 0 ) {
+	typedef detail::ClosestPairSolver::Item Item;
+	int const GRAIN = 1 << 14;  // 每个线程至少处理的点数
+
+	ClosestPairResult best = { -1, -1, std::numeric_limits< double >::infinity() };
+	if ( n < 2 ) {
+		return best;
+	}
+	std::vector< Item > items( n ), tmp( n );
+	for( int i=0; i<n; ++i ) {
+		Item item = { (double)pts[i].x, (double)pts[i].y, i };
+		items[i] = item;
+	}
+	int depth = 0;
+	for( int t=detail::work_threads( threads, n, GRAIN ); t>1; t=(t+1)/2 ) {
+		++depth;
+	}
+	detail::parallel_sort( items.begin(), items.end(), detail::ClosestPairSolver::LessX(), 1 << depth );
+	detail::ClosestPairSolver::solve( &items[0], &tmp[0], n, depth, best );
+	return best;
+}
+
+}
@@ -0,0 +1,97 @@
+/*
+ * @file  include/geometry/ConvexHull.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <concurrent/Parallel.hpp>
+#include <geometry/Predicates.hpp>
+
+namespace BR {
+namespace detail {
+
+template< class Point >
+struct HullLess {
+	bool operator()( Point const & lhs, Point const & rhs ) const {
+		return lhs.x < rhs.x || ( lhs.x == rhs.x && lhs.y < rhs.y );
+	}
+};
+
+template< class Point >
+struct HullEqual {
+	bool operator()( Point const & lhs, Point const & rhs ) const {
+		return lhs.x == rhs.x && lhs.y == rhs.y;
+	}
+};
+
+/*
+ *  Andrew 单调链：pts 会被排序去重，凸包逆时针写入 hull
+ */
+template< class Point >
+void monotone_chain( std::vector< Point > & pts, std::vector< Point > & hull ) {
+	std::sort( pts.begin(), pts.end(), HullLess< Point >() );
+	pts.erase( std::unique( pts.begin(), pts.end(), HullEqual< Point >() ), pts.end() );
+	int n = (int)pts.size();
+	if ( n < 3 ) {
+		hull = pts;
+		return;
+	}
+
+	hull.resize( 2 * n );
+	int k = 0;
+	for( int i=0; i<n; ++i ) {
+		while ( k >= 2 && orient2d( hull[k-2], hull[k-1], pts[i] ) <= 0 ) {
+			--k;
+		}
+		hull[k++] = pts[i];
+	}
+	for( int i=n-2, lower=k+1; i>=0; --i ) {
+		while ( k >= lower && orient2d( hull[k-2], hull[k-1], pts[i] ) <= 0 ) {
+			--k;
+		}
+		hull[k++] = pts[i];
+	}
+	// 最后一个点与第一个点重合
+	hull.resize( k - 1 );
+}
+
+} // namespace detail
+
+/*
+ *  @brief 点集的凸包，O(n log n)
+ *  @param  Point  带 x、y 成员的点类型，如 Point2D<double>
+ *
+ *  hull 按逆时针排列，从 x 最小（其次 y 最小）的点开始，不含共线的中间点与重复点；
+ *  全部点共线时只有两个端点。朝向由 orient2d 精确判断，近乎共线的输入也不会产生凹角。
+ *  点数较多时把输入分给 threads 个线程各求一个凸包，再对这些凸包的顶点求一次凸包。
+ */
+template< class Point >
+void convex_hull( Point const * pts, int n, std::vector< Point > & hull, int threads = 0 ) {
+	int const GRAIN = 1 << 15;  // 每个线程至少处理的点数
+
+	int chunks = detail::work_threads( threads, n, GRAIN );
+	if ( chunks == 1 ) {
+		std::vector< Point > work( pts, pts + n );
+		detail::monotone_chain( work, hull );
+		return;
+	}
+
+	std::vector< std::vector< Point > > partial( chunks );
+	detail::parallel_for( chunks, chunks, [&]( int begin, int end ) {
+		for( int c=begin; c<end; ++c ) {
+			std::vector< Point > work( pts + (long long)n * c / chunks, pts + (long long)n * ( c + 1 ) / chunks );
+			detail::monotone_chain( work, partial[c] );
+		}
+	} );
+	std::vector< Point > merged;
+	for( int c=0; c<chunks; ++c ) {
+		merged.insert( merged.end(), partial[c].begin(), partial[c].end() );
+	}
+	detail::monotone_chain( merged, hull );
+}
+
+}
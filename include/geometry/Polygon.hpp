@@ -0,0 +1,134 @@
+/*
+ * @file  include/geometry/Polygon.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <vector>
+
+#include <concurrent/Parallel.hpp>
+#include <geometry/Predicates.hpp>
+#include <math/Point2D.hpp>
+
+namespace BR {
+namespace detail {
+
+/*
+ *  顶点 [begin, end) 起始的各边的鞋带公式部分和；坐标先减去 origin 以减小抵消误差
+ */
+struct ShoelaceSum {
+	double area2;  // 面积的两倍
+	double cx6;    // 重心 x 乘以 6 倍面积
+	double cy6;
+
+	template< class Point >
+	void add( Point const * poly, int n, int begin, int end, double ox, double oy ) {
+		for( int i=begin; i<end; ++i ) {
+			int j = i + 1 == n ? 0 : i + 1;
+			double xi = poly[i].x - ox, yi = poly[i].y - oy;
+			double xj = poly[j].x - ox, yj = poly[j].y - oy;
+			double cross = xi * yj - xj * yi;
+			area2 += cross;
+			cx6 += ( xi + xj ) * cross;
+			cy6 += ( yi + yj ) * cross;
+		}
+	}
+};
+
+template< class Point >
+ShoelaceSum shoelace( Point const * poly, int n, int threads ) {
+	int const GRAIN = 1 << 16;  // 每个线程至少处理的顶点数
+
+	ShoelaceSum total = { 0.0, 0.0, 0.0 };
+	if ( n == 0 ) {
+		return total;
+	}
+	double ox = poly[0].x, oy = poly[0].y;
+	int chunks = work_threads( threads, n, GRAIN );
+	std::vector< ShoelaceSum > partial( chunks, total );
+	parallel_for( chunks, chunks, [&]( int begin, int end ) {
+		for( int c=begin; c<end; ++c ) {
+			partial[c].add( poly, n, (int)( (long long)n * c / chunks ), (int)( (long long)n * ( c + 1 ) / chunks ), ox, oy );
+		}
+	} );
+	for( int c=0; c<chunks; ++c ) {
+		total.area2 += partial[c].area2;
+		total.cx6 += partial[c].cx6;
+		total.cy6 += partial[c].cy6;
+	}
+	return total;
+}
+
+} // namespace detail
+
+/*
+ *  @brief 简单多边形的有向面积（鞋带公式），顶点逆时针时为正
+ *
+ *  顶点数较多时各线程分段求和，结果与单线程只有舍入上的差别。
+ */
+template< class Point >
+double polygon_area( Point const * poly, int n, int threads = 0 ) {
+	return detail::shoelace( poly, n, threads ).area2 * 0.5;
+}
+
+/*
+ *  简单多边形的重心；面积为 0 时返回顶点的平均值
+ */
+template< class Point >
+Point2D< double > polygon_centroid( Point const * poly, int n, int threads = 0 ) {
+	if ( n == 0 ) {
+		return Point2D< double >();
+	}
+	detail::ShoelaceSum sum = detail::shoelace( poly, n, threads );
+	if ( sum.area2 == 0.0 ) {
+		double x = 0.0, y = 0.0;
+		for( int i=0; i<n; ++i ) {
+			x += poly[i].x;
+			y += poly[i].y;
+		}
+		return Point2D< double >( x / n, y / n );
+	}
+	return Point2D< double >( poly[0].x + sum.cx6 / ( 3.0 * sum.area2 ), poly[0].y + sum.cy6 / ( 3.0 * sum.area2 ) );
+}
+
+/*
+ *  @brief 射线法判断 q 是否在多边形内部
+ *
+ *  向 +x 方向的射线与各边求交，边按下闭上开的区间计入，交点是否在 q 右侧由 orient2d 精确判断，
+ *  因此结果不受舍入影响；恰好落在边上的点归属于哪一侧由该规则决定，但总是确定的。
+ */
+template< class Point, class Query >
+bool point_in_polygon( Point const * poly, int n, Query const & q ) {
+	bool inside = false;
+	for( int i=0, j=n-1; i<n; j=i++ ) {
+		Point const & a = poly[j];
+		Point const & b = poly[i];
+		if ( ( a.y <= q.y ) == ( b.y <= q.y ) ) {
+			continue;
+		}
+		// 向上的边与 q 在其左侧等价于交点在 q 右侧，向下的边相反
+		int side = orient2d( a, b, q );
+		if ( b.y > a.y ? side > 0 : side < 0 ) {
+			inside = !inside;
+		}
+	}
+	return inside;
+}
+
+/*
+ *  对 m 个查询点批量判断，inside[k] 为 qs[k] 的结果；查询分给 threads 个线程
+ */
+template< class Point, class Query >
+void points_in_polygon( Point const * poly, int n, Query const * qs, int m, char * inside, int threads = 0 ) {
+	int const GRAIN = 1 << 20;  // 每个线程至少处理的 查询数*顶点数
+
+	int grain = n > 0 ? GRAIN / n + 1 : m + 1;
+	detail::parallel_for( m, detail::work_threads( threads, m, grain ), [&]( int begin, int end ) {
+		for( int k=begin; k<end; ++k ) {
+			inside[k] = point_in_polygon( poly, n, qs[k] );
+		}
+	} );
+}
+
+}
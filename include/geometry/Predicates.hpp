@@ -0,0 +1,117 @@
+/*
+ * @file  include/geometry/Predicates.hpp
+ * @brief 鲁棒的几何谓词
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <cmath>
+
+namespace BR {
+namespace detail {
+
+/*
+ *  Shewchuk 的无误差变换：a + b == x + y，a * b == x + y，结果精确。
+ *  要求按 IEEE double 舍入：x87 扩展精度或 -ffast-math 下不成立
+ */
+inline void two_sum( double a, double b, double & x, double & y ) {
+	x = a + b;
+	double bv = x - a;
+	double av = x - bv;
+	y = ( a - av ) + ( b - bv );
+}
+
+inline void two_product( double a, double b, double & x, double & y ) {
+	double const SPLITTER = 134217729.0;  // 2^27 + 1
+	x = a * b;
+	double c = SPLITTER * a;
+	double ahi = c - ( c - a );
+	double alo = a - ahi;
+	c = SPLITTER * b;
+	double bhi = c - ( c - b );
+	double blo = b - bhi;
+	y = alo * blo - ( ( ( x - ahi * bhi ) - alo * bhi ) - ahi * blo );
+}
+
+/*
+ *  把 b 加入按绝对值递增、互不重叠的展开式 e（长度 n），去掉零分量，返回新长度
+ */
+inline int grow_expansion( double * e, int n, double b ) {
+	double q = b;
+	int len = 0;
+	for( int i=0; i<n; ++i ) {
+		double sum, err;
+		two_sum( q, e[i], sum, err );
+		q = sum;
+		if ( err != 0.0 ) {
+			e[len++] = err;
+		}
+	}
+	if ( q != 0.0 || len == 0 ) {
+		e[len++] = q;
+	}
+	return len;
+}
+
+/*
+ *  用展开式精确计算 ax*by - ay*bx + bx*cy - by*cx + cx*ay - cy*ax 的符号
+ */
+inline int orient2d_exact( double ax, double ay, double bx, double by, double cx, double cy ) {
+	double const terms[6][2] = {
+		{ ax, by }, { -ay, bx }, { bx, cy }, { -by, cx }, { cx, ay }, { -cy, ax }
+	};
+	double e[13];
+	int n = 0;
+	for( int i=0; i<6; ++i ) {
+		double hi, lo;
+		two_product( terms[i][0], terms[i][1], hi, lo );
+		n = grow_expansion( e, n, lo );
+		n = grow_expansion( e, n, hi );
+	}
+	// 最高分量决定整个展开式的符号
+	return ( e[n-1] > 0.0 ) - ( e[n-1] < 0.0 );
+}
+
+} // namespace detail
+
+/*
+ *  @brief c 在有向直线 a->b 的哪一侧：1 为左侧（a、b、c 逆时针），-1 为右侧，0 为共线
+ *
+ *  先按 Shewchuk 的误差界用浮点结果判断，只有结果可能因舍入而变号时才精确计算，
+ *  因此对任意 double 坐标都给出正确的符号。坐标先转换为 double，
+ *  所以 float 与不超过 53 位的整数坐标同样精确。
+ */
+template< class Point, class Query >
+int orient2d( Point const & a, Point const & b, Query const & c ) {
+	double const EPSILON = 1.1102230246251565e-16;  // 2^-53
+	double const ERRBOUND = ( 3.0 + 16.0 * EPSILON ) * EPSILON;
+
+	double ax = (double)a.x, ay = (double)a.y;
+	double bx = (double)b.x, by = (double)b.y;
+	double cx = (double)c.x, cy = (double)c.y;
+	double left = ( ax - cx ) * ( by - cy );
+	double right = ( ay - cy ) * ( bx - cx );
+	double det = left - right;
+	double detsum;
+	if ( left > 0.0 ) {
+		if ( right <= 0.0 ) {
+			return ( det > 0.0 ) - ( det < 0.0 );
+		}
+		detsum = left + right;
+	} else if ( left < 0.0 ) {
+		if ( right >= 0.0 ) {
+			return ( det > 0.0 ) - ( det < 0.0 );
+		}
+		detsum = -left - right;
+	} else {
+		return ( det > 0.0 ) - ( det < 0.0 );
+	}
+	double bound = ERRBOUND * detsum;
+	if ( det >= bound || -det >= bound ) {
+		return ( det > 0.0 ) - ( det < 0.0 );
+	}
+	return detail::orient2d_exact( ax, ay, bx, by, cx, cy );
+}
+
+}
@@ -0,0 +1,114 @@
+/** 
+ * @file  include/math/AABB2D.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <ios>
+#include <sstream>
+
+#include <math/XYPair.hpp>
+
+namespace BR {
+/**
+ *  @brief 2D axis-aligned bounding box
+ *  @ingroup math
+ *  @param  Tp  type of element
+ *
+ *  闭区间 [lo, hi]，构造时把两个角点整理成 lo <= hi；边界相接也算重叠。
+ */
+template< class Tp >
+struct AABB2D {
+	BR_VALTYPE_SERIES( Tp )
+	BR_SELFTYPE_SERIES( AABB2D<ValType> )
+	typedef XYPair<ValType>    CornerType;
+
+	typedef ValType value_type;
+
+	CornerType lo, hi;
+
+	AABB2D( void ) : lo(), hi() { }
+
+	template< class Up, class Vp >
+	AABB2D( XYPair< Up > const & a, XYPair< Vp > const & b )
+		: lo( a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y ), hi( a.x < b.x ? b.x : a.x, a.y < b.y ? b.y : a.y ) { }
+
+	/*
+	 *  退化为一个点的盒子
+	 */
+	template< class Up >
+	explicit AABB2D( XYPair< Up > const & p ) : lo( p ), hi( p ) { }
+
+	/*
+	 *  operation
+	 */
+	template< class Up >
+	BR_CONSTEXPR bool overlaps( AABB2D< Up > const & rhs ) const {
+		return lo.x <= rhs.hi.x && rhs.lo.x <= hi.x && lo.y <= rhs.hi.y && rhs.lo.y <= hi.y;
+	}
+
+	template< class Up >
+	BR_CONSTEXPR bool contains( XYPair< Up > const & p ) const {
+		return lo.x <= p.x && p.x <= hi.x && lo.y <= p.y && p.y <= hi.y;
+	}
+
+	template< class Up >
+	BR_CONSTEXPR bool contains( AABB2D< Up > const & rhs ) const {
+		return lo.x <= rhs.lo.x && rhs.hi.x <= hi.x && lo.y <= rhs.lo.y && rhs.hi.y <= hi.y;
+	}
+
+	/*
+	 *  扩展到同时包含 rhs
+	 */
+	template< class Up >
+	SelfRefType merge( AABB2D< Up > const & rhs ) {
+		if ( rhs.lo.x < lo.x ) lo.x = rhs.lo.x;
+		if ( rhs.lo.y < lo.y ) lo.y = rhs.lo.y;
+		if ( hi.x < rhs.hi.x ) hi.x = rhs.hi.x;
+		if ( hi.y < rhs.hi.y ) hi.y = rhs.hi.y;
+		return *this;
+	}
+
+	template< class Up >
+	SelfType merged( AABB2D< Up > const & rhs ) const {
+		return SelfType( *this ).merge( rhs );
+	}
+
+	BR_CONSTEXPR ValType width( void ) const {
+		return hi.x - lo.x;
+	}
+
+	BR_CONSTEXPR ValType height( void ) const {
+		return hi.y - lo.y;
+	}
+
+	BR_CONSTEXPR ValType area( void ) const {
+		return ( hi.x - lo.x ) * ( hi.y - lo.y );
+	}
+
+	/*
+	 *  中心坐标的两倍，整数类型下不丢精度，只用于比较时足够
+	 */
+	BR_CONSTEXPR CornerType center2( void ) const {
+		return CornerType( lo.x + hi.x, lo.y + hi.y );
+	}
+};
+
+template< class Tp, class Up >
+BR_CONSTEXPR inline bool overlaps(
+	AABB2D< Tp > const & lhs,
+	AABB2D< Up > const & rhs
+) {
+	return lhs.overlaps( rhs );
+}
+
+template< class ValType, class CharType, class CharTraits >
+std::basic_ostream< CharType, CharTraits >& operator<<(
+	std::basic_ostream< CharType, CharTraits > & ostr,
+	AABB2D< ValType > const & rhs
+) {
+	return ostr << '[' << rhs.lo << ',' << rhs.hi << ']';
+}
+
+}
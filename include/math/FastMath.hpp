@@ -0,0 +1,150 @@
+/*
+ * @file  include/math/FastMath.hpp
+ * @brief sqrt、rsqrt、atan2 的精确与近似实现，作为数学运算的策略参数
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include HEADER_STDINT
+
+#include <simd/CpuFeatures.hpp>
+
+namespace BR {
+/*
+ *  @brief 精确策略，直接调用 <cmath>
+ */
+struct ExactMath {
+	template< class Tp >
+	static Tp sqrt( Tp x ) {
+		return std::sqrt( x );
+	}
+
+	template< class Tp >
+	static Tp rsqrt( Tp x ) {
+		return Tp( 1 ) / std::sqrt( x );
+	}
+
+	template< class Tp >
+	static Tp atan2( Tp y, Tp x ) {
+		return std::atan2( y, x );
+	}
+};
+
+/*
+ *  @brief 近似策略，sqrt/rsqrt 相对误差约 1e-6，用于能容忍误差的热点（如碰撞检测）
+ *
+ *  rsqrt 用 rsqrtss 的 12 位近似加一步牛顿迭代（非 x86 时用整数初值加两步迭代）；
+ *  sqrt(x) = x * rsqrt(x)，在 sqrtss 本身已很快的处理器上未必更快，主要收益来自 rsqrt 与 atan2；
+ *  atan2 先把比值归约到 [0, 1]，再用 11 次奇多项式逼近 atan，绝对误差约 4e-6 弧度。
+ *  double 参数保留 double 的取值范围：rsqrt 以 float 近似为初值、在 double 中做牛顿迭代，
+ *  超出 float 正规数范围的参数先按 2 的偶数次幂缩放；atan2 在 double 中归约比值，
+ *  只有多项式按 float 计算，因此精度与 float 版本相同。
+ *  不处理负数、无穷与 NaN，atan2(0, 0) 返回 0。
+ */
+struct FastMath {
+	static float rsqrt( float x ) {
+#ifdef BR_HAS_X86_SIMD
+		float r = _mm_cvtss_f32( _mm_rsqrt_ss( _mm_set_ss( x ) ) );
+		return r * ( 1.5f - 0.5f * x * r * r );
+#else
+		std::uint32_t bits;
+		memcpy( &bits, &x, sizeof(bits) );
+		bits = 0x5f375a86u - ( bits >> 1 );
+		float r;
+		memcpy( &r, &bits, sizeof(r) );
+		r = r * ( 1.5f - 0.5f * x * r * r );
+		return r * ( 1.5f - 0.5f * x * r * r );
+#endif // BR_HAS_X86_SIMD
+	}
+
+	static float sqrt( float x ) {
+		return x == 0.0f ? 0.0f : x * rsqrt( x );
+	}
+
+	static float atan2( float y, float x ) {
+		float ax = std::fabs( x ), ay = std::fabs( y );
+		float hi = ax > ay ? ax : ay;
+		if ( hi == 0.0f ) {
+			return 0.0f;
+		}
+		return atan_octant( ( ax > ay ? ay : ax ) / hi, ay > ax, x < 0.0f, y < 0.0f );
+	}
+
+	static double rsqrt( double x ) {
+		if ( ( x > 0.0 && x < FLT_MIN ) || ( x > FLT_MAX && x <= DBL_MAX ) ) {
+			// 缩放到 [0.5, 2) 后求值：rsqrt( m * 2^(2k) ) = rsqrt( m ) * 2^-k
+			int e;
+			double m = std::frexp( x, &e );
+			if ( e & 1 ) {
+				m *= 2.0;
+				--e;
+			}
+			return std::ldexp( rsqrt( m ), -e / 2 );
+		}
+		double r = rsqrt( float( x ) );
+		return r * ( 1.5 - 0.5 * x * r * r );
+	}
+
+	static double sqrt( double x ) {
+		return x == 0.0 ? 0.0 : x * rsqrt( x );
+	}
+
+	static double atan2( double y, double x ) {
+		double ax = std::fabs( x ), ay = std::fabs( y );
+		double hi = ax > ay ? ax : ay;
+		if ( hi == 0.0 ) {
+			return 0.0;
+		}
+		return atan_octant( float( ( ax > ay ? ay : ax ) / hi ), ay > ax, x < 0.0, y < 0.0 );
+	}
+
+	/*
+	 *  其他类型（如整数向量的长度）没有近似实现，在编译期拒绝，而不是隐式转换后产生二义性
+	 */
+	template< class Tp >
+	static Tp rsqrt( Tp x ) {
+		static_assert( sizeof(Tp) == 0, "FastMath only supports float and double" );
+		return x;
+	}
+
+	template< class Tp >
+	static Tp sqrt( Tp x ) {
+		static_assert( sizeof(Tp) == 0, "FastMath only supports float and double" );
+		return x;
+	}
+
+	template< class Tp >
+	static Tp atan2( Tp y, Tp ) {
+		static_assert( sizeof(Tp) == 0, "FastMath only supports float and double" );
+		return y;
+	}
+
+private:
+	/*
+	 *  a = min(|x|,|y|) / max(|x|,|y|) 位于 [0, 1]，再按象限还原出 atan2
+	 */
+	static float atan_octant( float a, bool steep, bool neg_x, bool neg_y ) {
+		float s = a * a;
+		float r = -0.013480470f;
+		r = r * s + 0.057477314f;
+		r = r * s - 0.121239071f;
+		r = r * s + 0.195635925f;
+		r = r * s - 0.332994597f;
+		r = r * s + 0.999995630f;
+		r *= a;
+		if ( steep ) {
+			r = 1.57079637f - r;
+		}
+		if ( neg_x ) {
+			r = 3.14159274f - r;
+		}
+		return neg_y ? -r : r;
+	}
+};
+
+}
@@ -28,6 +28,10 @@ struct Point2D : XYPair< Tp > {
 	typedef Vector2D<ValType> VecType;
 
 	typedef ValType value_type;
+
+	using SuperType::x;
+	using SuperType::y;
+	using SuperType::assign;
 	/*
 	 *  constructor
 	 */
@@ -41,7 +45,7 @@ struct Point2D : XYPair< Tp > {
 
 	template< class Up, class Vp >
 	BR_CONSTEXPR explicit Point2D( Point2D< Up > const & src, Vector2D< Vp > const & vec )
-		: x( src.x + vec.x ), y( src.y + vec.y ) { }
+		: SuperType( src.x + vec.x, src.y + vec.y ) { }
 
 	/*
 	 *  assignment
@@ -73,7 +77,7 @@ struct Point2D : XYPair< Tp > {
 	/*
 	 *  operator
 	 */
-	BR_CONSTEXPR SelfRefType operator+( void ) {
+	SelfRefType operator+( void ) {
 		return *this;
 	}
 
@@ -98,7 +102,7 @@ struct Point2D : XYPair< Tp > {
 		Point2D< Up > const & lhs,
 		Point2D< Vp > const & rhs
 	) {
-		return SelfType( lhs, rhs ).norm_sqr();
+		return ValType( lhs.x - rhs.x ) * ValType( lhs.x - rhs.x ) + ValType( lhs.y - rhs.y ) * ValType( lhs.y - rhs.y );
 	}
 
 	template< class Up, class Vp >
@@ -106,7 +110,7 @@ struct Point2D : XYPair< Tp > {
 		Point2D< Up > const & lhs,
 		Point2D< Vp > const & rhs
 	) {
-		return SelfType( lhs, rhs ).norm();
+		return std::sqrt( Euclid_dist_sqr( lhs, rhs ) );
 	}
 };
 
@@ -0,0 +1,301 @@
+/** 
+ * @file  include/math/Transform2D.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <cmath>
+#include <ios>
+#include <sstream>
+
+#include <math/Point2D.hpp>
+#include <math/Vector2D.hpp>
+#include <math/Vector2DBulk.hpp>
+#include <simd/CpuFeatures.hpp>
+
+namespace BR {
+namespace detail {
+/*
+ *  交错存放的 x0, y0, x1, y1, ... 上做 x' = a*x + b*y + tx，y' = c*x + d*y + ty，
+ *  向量传入 tx = ty = 0；SIMD 版本的运算顺序与标量版本相同，结果逐位一致
+ */
+template< class Tp >
+void xform2_scalar( Tp * dst, Tp const * src, Tp const * m, int n, int from = 0 ) {
+	for( int i=from; i<n; ++i ) {
+		Tp x = src[2*i], y = src[2*i+1];
+		dst[2*i] = ( m[0] * x + m[1] * y ) + m[4];
+		dst[2*i+1] = ( m[3] * y + m[2] * x ) + m[5];
+	}
+}
+
+#ifdef BR_HAS_X86_SIMD
+/*
+ *  v = [x, y]，w = [y, x]：结果为 v * [a, d] + w * [b, c] + [tx, ty]
+ */
+inline void xform2_sse2( float * dst, float const * src, float const * m, int n ) {
+	__m128 va = _mm_setr_ps( m[0], m[3], m[0], m[3] );
+	__m128 vb = _mm_setr_ps( m[1], m[2], m[1], m[2] );
+	__m128 vt = _mm_setr_ps( m[4], m[5], m[4], m[5] );
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		__m128 v = _mm_loadu_ps( src + 2*i );
+		__m128 w = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+		_mm_storeu_ps( dst + 2*i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( v, va ), _mm_mul_ps( w, vb ) ), vt ) );
+	}
+	xform2_scalar( dst, src, m, n, i );
+}
+
+inline void xform2_sse2( double * dst, double const * src, double const * m, int n ) {
+	__m128d va = _mm_setr_pd( m[0], m[3] );
+	__m128d vb = _mm_setr_pd( m[1], m[2] );
+	__m128d vt = _mm_setr_pd( m[4], m[5] );
+	for( int i=0; i<n; ++i ) {
+		__m128d v = _mm_loadu_pd( src + 2*i );
+		_mm_storeu_pd( dst + 2*i, _mm_add_pd( _mm_add_pd( _mm_mul_pd( v, va ), _mm_mul_pd( _mm_shuffle_pd( v, v, 1 ), vb ) ), vt ) );
+	}
+}
+
+BR_TARGET_AVX2 inline void xform2_avx2( float * dst, float const * src, float const * m, int n ) {
+	__m256 va = _mm256_setr_ps( m[0], m[3], m[0], m[3], m[0], m[3], m[0], m[3] );
+	__m256 vb = _mm256_setr_ps( m[1], m[2], m[1], m[2], m[1], m[2], m[1], m[2] );
+	__m256 vt = _mm256_setr_ps( m[4], m[5], m[4], m[5], m[4], m[5], m[4], m[5] );
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m256 v = _mm256_loadu_ps( src + 2*i );
+		__m256 w = _mm256_permute_ps( v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+		_mm256_storeu_ps( dst + 2*i, _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( v, va ), _mm256_mul_ps( w, vb ) ), vt ) );
+	}
+	xform2_scalar( dst, src, m, n, i );
+}
+
+BR_TARGET_AVX2 inline void xform2_avx2( double * dst, double const * src, double const * m, int n ) {
+	__m256d va = _mm256_setr_pd( m[0], m[3], m[0], m[3] );
+	__m256d vb = _mm256_setr_pd( m[1], m[2], m[1], m[2] );
+	__m256d vt = _mm256_setr_pd( m[4], m[5], m[4], m[5] );
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		__m256d v = _mm256_loadu_pd( src + 2*i );
+		_mm256_storeu_pd( dst + 2*i, _mm256_add_pd( _mm256_add_pd( _mm256_mul_pd( v, va ), _mm256_mul_pd( _mm256_permute_pd( v, 5 ), vb ) ), vt ) );
+	}
+	xform2_scalar( dst, src, m, n, i );
+}
+#endif // BR_HAS_X86_SIMD
+
+/*
+ *  按分量类型选择实现：float、double 按运行时指令集分派，其他类型使用标量循环
+ */
+template< class Tp >
+struct Xform2Bulk {
+	static void apply( Tp * dst, Tp const * src, Tp const * m, int n ) {
+		xform2_scalar( dst, src, m, n );
+	}
+};
+
+#ifdef BR_HAS_X86_SIMD
+template< class Tp >
+struct Xform2BulkSIMD {
+	static void apply( Tp * dst, Tp const * src, Tp const * m, int n ) {
+		return simd::has_avx2() ? xform2_avx2( dst, src, m, n ) : xform2_sse2( dst, src, m, n );
+	}
+};
+
+template<>
+struct Xform2Bulk< float > : Xform2BulkSIMD< float > {
+};
+
+template<>
+struct Xform2Bulk< double > : Xform2BulkSIMD< double > {
+};
+#endif // BR_HAS_X86_SIMD
+
+} // namespace detail
+
+/**
+ *  @brief 2D affine transform
+ *  @ingroup math
+ *  @param  Tp  type of element
+ *
+ *  2x3 矩阵 [a b tx; c d ty]：点 p 变换为 (a*p.x + b*p.y + tx, c*p.x + d*p.y + ty)，
+ *  向量只乘线性部分、不平移。
+ *  translate/rotate/scale 在当前变换之后再追加一步，先组合好整条变换链，
+ *  再对整个数组调用一次 apply，三角函数只在组合时计算一次。
+ *  lhs * rhs 表示先做 rhs 再做 lhs。
+ */
+template< class Tp >
+struct Transform2D {
+	BR_VALTYPE_SERIES( Tp )
+	BR_SELFTYPE_SERIES( Transform2D<ValType> )
+	typedef Point2D<ValType>  PointType;
+	typedef Vector2D<ValType> VecType;
+
+	typedef ValType value_type;
+
+	ValType a, b, c, d, tx, ty;
+
+	/*
+	 *  constructor
+	 */
+	BR_CONSTEXPR Transform2D( void ) : a( 1 ), b( 0 ), c( 0 ), d( 1 ), tx( 0 ), ty( 0 ) { }
+
+	BR_CONSTEXPR Transform2D( ValType aa, ValType bb, ValType cc, ValType dd, ValType xx, ValType yy )
+		: a( aa ), b( bb ), c( cc ), d( dd ), tx( xx ), ty( yy ) { }
+
+	static SelfType translation( ValType dx, ValType dy ) {
+		return SelfType( 1, 0, 0, 1, dx, dy );
+	}
+
+	template< class Up >
+	static SelfType translation( Vector2D< Up > const & vec ) {
+		return SelfType( 1, 0, 0, 1, vec.x, vec.y );
+	}
+
+	/*
+	 *  逆时针旋转，同 Vector2D::rotate
+	 */
+	static SelfType rotation( ValType val_sin, ValType val_cos ) {
+		return SelfType( val_cos, -val_sin, val_sin, val_cos, 0, 0 );
+	}
+
+	static SelfType rotation( ValType angle ) {
+		return rotation( std::sin( angle ), std::cos( angle ) );
+	}
+
+	static SelfType scaling( ValType sx, ValType sy ) {
+		return SelfType( sx, 0, 0, sy, 0, 0 );
+	}
+
+	static SelfType scaling( ValType k ) {
+		return SelfType( k, 0, 0, k, 0, 0 );
+	}
+
+	/*
+	 *  composition
+	 */
+	BR_CONSTEXPR SelfType mul( CSelfRefType rhs ) const {
+		return SelfType(
+			a * rhs.a + b * rhs.c, a * rhs.b + b * rhs.d,
+			c * rhs.a + d * rhs.c, c * rhs.b + d * rhs.d,
+			a * rhs.tx + b * rhs.ty + tx, c * rhs.tx + d * rhs.ty + ty
+		);
+	}
+
+	/*
+	 *  先做当前变换，再做 rhs
+	 */
+	SelfRefType then( CSelfRefType rhs ) {
+		return *this = rhs.mul( *this );
+	}
+
+	SelfRefType translate( ValType dx, ValType dy ) {
+		tx += dx;
+		ty += dy;
+		return *this;
+	}
+
+	template< class Up >
+	SelfRefType translate( Vector2D< Up > const & vec ) {
+		return translate( vec.x, vec.y );
+	}
+
+	SelfRefType rotate( ValType val_sin, ValType val_cos ) {
+		return then( rotation( val_sin, val_cos ) );
+	}
+
+	SelfRefType rotate( ValType angle ) {
+		return then( rotation( angle ) );
+	}
+
+	SelfRefType scale( ValType sx, ValType sy ) {
+		return then( scaling( sx, sy ) );
+	}
+
+	SelfRefType scale( ValType k ) {
+		return then( scaling( k ) );
+	}
+
+	BR_CONSTEXPR ValType determinant( void ) const {
+		return a * d - b * c;
+	}
+
+	/*
+	 *  逆变换；变换不可逆（行列式为 0）时结果无意义
+	 */
+	SelfType inverse( void ) const {
+		ValType det = determinant();
+		BR_ASSERT( det != 0 );
+		ValType ia = d / det, ib = -b / det, ic = -c / det, id = a / det;
+		return SelfType( ia, ib, ic, id, -( ia * tx + ib * ty ), -( ic * tx + id * ty ) );
+	}
+
+	/*
+	 *  application
+	 */
+	template< class Up >
+	BR_CONSTEXPR PointType apply( Point2D< Up > const & p ) const {
+		return PointType( ( a * p.x + b * p.y ) + tx, ( d * p.y + c * p.x ) + ty );
+	}
+
+	template< class Up >
+	BR_CONSTEXPR VecType apply( Vector2D< Up > const & vec ) const {
+		return VecType( a * vec.x + b * vec.y, d * vec.y + c * vec.x );
+	}
+
+	/*
+	 *  对 n 个点批量变换，dst 可以与 src 相同；float、double 使用 SSE2/AVX2
+	 */
+	void apply( PointType * dst, PointType const * src, int n ) const {
+		ValType const m[6] = { a, b, c, d, tx, ty };
+		bulk_apply( dst, src, m, n );
+	}
+
+	/*
+	 *  对 n 个向量批量变换，不平移
+	 */
+	void apply( VecType * dst, VecType const * src, int n ) const {
+		ValType const m[6] = { a, b, c, d, 0, 0 };
+		bulk_apply( dst, src, m, n );
+	}
+
+	/*
+	 *  operator
+	 */
+	template< class Up >
+	BR_CONSTEXPR PointType operator()( Point2D< Up > const & p ) const {
+		return apply( p );
+	}
+
+	template< class Up >
+	BR_CONSTEXPR VecType operator()( Vector2D< Up > const & vec ) const {
+		return apply( vec );
+	}
+
+	SelfRefType operator*=( CSelfRefType rhs ) {
+		return *this = mul( rhs );
+	}
+
+private:
+	template< class Vec >
+	static void bulk_apply( Vec * dst, Vec const * src, ValType const * m, int n ) {
+		typedef detail::Vec2Layout< Vec > L;
+		detail::Xform2Bulk< ValType >::apply( L::comp( dst ), L::comp( src ), m, n );
+	}
+};
+
+template< class Tp >
+BR_CONSTEXPR inline Transform2D< Tp > operator*(
+	Transform2D< Tp > const & lhs,
+	Transform2D< Tp > const & rhs
+) {
+	return lhs.mul( rhs );
+}
+
+template< class ValType, class CharType, class CharTraits >
+std::basic_ostream< CharType, CharTraits >& operator<<(
+	std::basic_ostream< CharType, CharTraits > & ostr,
+	Transform2D< ValType > const & rhs
+) {
+	return ostr << '[' << rhs.a << ' ' << rhs.b << ' ' << rhs.tx << ';' << rhs.c << ' ' << rhs.d << ' ' << rhs.ty << ']';
+}
+
+}
@@ -11,11 +11,41 @@
 #include HEADER_TYPE_TRAITS
 #include <tuple>
 
+#include <math/FastMath.hpp>
 #include <math/XYPair.hpp>
 
 namespace BR {
 template< class Tp >
 struct Point2D;
+
+namespace detail {
+/*
+ *  把 (x, y) 缩放为单位向量：近似策略乘以 rsqrt
+ */
+template< class Math >
+struct Vec2Unit {
+	template< class Tp >
+	static void apply( Tp & x, Tp & y, Tp len_sqr ) {
+		Tp inv = Math::rsqrt( len_sqr );
+		x *= inv;
+		y *= inv;
+	}
+};
+
+/*
+ *  精确策略直接除以长度，结果与 vec2_normalize 逐位一致，整数向量也按整数除法
+ */
+template<>
+struct Vec2Unit< ExactMath > {
+	template< class Tp >
+	static void apply( Tp & x, Tp & y, Tp len_sqr ) {
+		Tp len = ExactMath::sqrt( len_sqr );
+		x /= len;
+		y /= len;
+	}
+};
+
+} // namespace detail
 /**
  *  @brief 2D vector
  *  @ingroup math
@@ -28,6 +58,10 @@ struct Vector2D : XYPair< Tp > {
 	typedef XYPair<ValType>    SuperType;
 
 	typedef ValType value_type;
+
+	using SuperType::x;
+	using SuperType::y;
+	using SuperType::assign;
 	/*
 	 *  constructor
 	 */
@@ -106,7 +140,7 @@ struct Vector2D : XYPair< Tp > {
 		return outer_product( rhs );
 	}
 
-	BR_CONSTEXPR SelfRefType pos( void ) {
+	SelfRefType pos( void ) {
 		return *this;
 	}
 
@@ -130,36 +164,45 @@ struct Vector2D : XYPair< Tp > {
 		return magnitude_sqr();
 	}
 
-	BR_CONSTEXPR ValType magnitude( void ) const {
-		return std::sqrt( magnitude() );
+	/*
+	 *  长度、单位化与辐角可选数学策略：默认 ExactMath，
+	 *  热点中可用 v.magnitude< FastMath >() 换成误差约 1e-6 的近似，见 math/FastMath.hpp
+	 */
+	template< class Math = ExactMath >
+	ValType magnitude( void ) const {
+		return Math::sqrt( magnitude_sqr() );
 	}
 
-	BR_CONSTEXPR ValType norm( void ) const {
-		return magnitude();
+	template< class Math = ExactMath >
+	ValType norm( void ) const {
+		return magnitude< Math >();
 	}
 
-	BR_CONSTEXPR ValType length( void ) const {
-		return magnitude();
+	template< class Math = ExactMath >
+	ValType length( void ) const {
+		return magnitude< Math >();
 	}
 
+	template< class Math = ExactMath >
 	SelfRefType unitize( void ) {
-		ValType len = magnitude();
-		x /= len;
-		y /= len;
+		detail::Vec2Unit< Math >::apply( x, y, magnitude_sqr() );
 		return *this;
 	}
 
-	BR_CONSTEXPR SelfRefType normalize( void ) {
-		return unitize();
+	template< class Math = ExactMath >
+	SelfRefType normalize( void ) {
+		return unitize< Math >();
 	}
 
+	template< class Math = ExactMath >
 	SelfType unit() const { 
-		ValType len = magnitude();
-		return SelfType( x / len, y / len );
+		SelfType result( *this );
+		return result.template unitize< Math >();
 	}
 
-	BR_CONSTEXPR ValType arg() const {
-		return std::atan2(y, x);
+	template< class Math = ExactMath >
+	ValType arg() const {
+		return Math::atan2( y, x );
 	}
 
 	BR_CONSTEXPR ValType tan_arg() const {
@@ -167,18 +210,19 @@ struct Vector2D : XYPair< Tp > {
 	}
 
 	template< class Up, class Vp >
-	BR_CONSTEXPR SelfRefType rotate( Up const & val_sin, Vp const & val_cos ) {
-		return assign( x * val_cos - y * val_sin, x * val_sin + y * val_cos );
+	SelfRefType rotate( Up const & val_sin, Vp const & val_cos ) {
+		assign( x * val_cos - y * val_sin, x * val_sin + y * val_cos );
+		return *this;
 	}
 
 	template< class Up >
-	BR_CONSTEXPR SelfRefType rotate( Up const & angle ) {
+	SelfRefType rotate( Up const & angle ) {
 		return rotate( std::sin( angle ), std::cos( angle ) );
 	}
 	/*
 	 *  operator
 	 */
-	BR_CONSTEXPR SelfRefType operator+( void ) {
+	SelfRefType operator+( void ) {
 		return *this;
 	}
 
@@ -0,0 +1,535 @@
+﻿/*
+ * @file  include/math/Vector2DBulk.hpp
+ * @brief 对 Vector2D 数组的批量运算
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <cmath>
+
+#include <simd/CpuFeatures.hpp>
+
+namespace BR {
+namespace detail {
+/*
+ *  以下函数中的数组是交错存放的 x0, y0, x1, y1, ...，n 为向量个数，from 为起始向量下标
+ */
+template< class Tp >
+void vec2_add_scalar( Tp * dst, Tp const * a, Tp const * b, int n, int from = 0 ) {
+	for( int i=from*2; i<n*2; ++i ) {
+		dst[i] = a[i] + b[i];
+	}
+}
+
+template< class Tp >
+void vec2_scale_scalar( Tp * dst, Tp const * a, Tp k, int n, int from = 0 ) {
+	for( int i=from*2; i<n*2; ++i ) {
+		dst[i] = a[i] * k;
+	}
+}
+
+template< class Tp >
+void vec2_dot_scalar( Tp * out, Tp const * a, Tp const * b, int n, int from = 0 ) {
+	for( int i=from; i<n; ++i ) {
+		out[i] = a[2*i] * b[2*i] + a[2*i+1] * b[2*i+1];
+	}
+}
+
+template< class Tp >
+void vec2_cross_scalar( Tp * out, Tp const * a, Tp const * b, int n, int from = 0 ) {
+	for( int i=from; i<n; ++i ) {
+		out[i] = a[2*i] * b[2*i+1] - a[2*i+1] * b[2*i];
+	}
+}
+
+template< class Tp >
+void vec2_magnitude_scalar( Tp * out, Tp const * a, int n, int from = 0 ) {
+	for( int i=from; i<n; ++i ) {
+		out[i] = std::sqrt( a[2*i] * a[2*i] + a[2*i+1] * a[2*i+1] );
+	}
+}
+
+template< class Tp >
+void vec2_normalize_scalar( Tp * dst, Tp const * a, int n, int from = 0 ) {
+	for( int i=from; i<n; ++i ) {
+		Tp len = std::sqrt( a[2*i] * a[2*i] + a[2*i+1] * a[2*i+1] );
+		dst[2*i] = a[2*i] / len;
+		dst[2*i+1] = a[2*i+1] / len;
+	}
+}
+
+template< class Tp >
+void vec2_rotate_scalar( Tp * dst, Tp const * a, Tp s, Tp c, int n, int from = 0 ) {
+	for( int i=from; i<n; ++i ) {
+		Tp x = a[2*i], y = a[2*i+1];
+		dst[2*i] = x * c - y * s;
+		dst[2*i+1] = y * c + x * s;
+	}
+}
+
+#ifdef BR_HAS_X86_SIMD
+/*
+ *  SSE2 版本：一个 float 寄存器放 2 个向量，一个 double 寄存器放 1 个向量
+ */
+inline void vec2_add_sse2( float * dst, float const * a, float const * b, int n ) {
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		_mm_storeu_ps( dst + 2*i, _mm_add_ps( _mm_loadu_ps( a + 2*i ), _mm_loadu_ps( b + 2*i ) ) );
+	}
+	vec2_add_scalar( dst, a, b, n, i );
+}
+
+inline void vec2_scale_sse2( float * dst, float const * a, float k, int n ) {
+	__m128 vk = _mm_set1_ps( k );
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		_mm_storeu_ps( dst + 2*i, _mm_mul_ps( _mm_loadu_ps( a + 2*i ), vk ) );
+	}
+	vec2_scale_scalar( dst, a, k, n, i );
+}
+
+inline void vec2_dot_sse2( float * out, float const * a, float const * b, int n ) {
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m128 p0 = _mm_mul_ps( _mm_loadu_ps( a + 2*i ), _mm_loadu_ps( b + 2*i ) );
+		__m128 p1 = _mm_mul_ps( _mm_loadu_ps( a + 2*i + 4 ), _mm_loadu_ps( b + 2*i + 4 ) );
+		__m128 xs = _mm_shuffle_ps( p0, p1, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		__m128 ys = _mm_shuffle_ps( p0, p1, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+		_mm_storeu_ps( out + i, _mm_add_ps( xs, ys ) );
+	}
+	vec2_dot_scalar( out, a, b, n, i );
+}
+
+inline void vec2_cross_sse2( float * out, float const * a, float const * b, int n ) {
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m128 b0 = _mm_loadu_ps( b + 2*i ), b1 = _mm_loadu_ps( b + 2*i + 4 );
+		// 交换 b 的 x、y 后相乘：偶数位为 ax*by，奇数位为 ay*bx
+		__m128 p0 = _mm_mul_ps( _mm_loadu_ps( a + 2*i ), _mm_shuffle_ps( b0, b0, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		__m128 p1 = _mm_mul_ps( _mm_loadu_ps( a + 2*i + 4 ), _mm_shuffle_ps( b1, b1, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		__m128 lhs = _mm_shuffle_ps( p0, p1, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		__m128 rhs = _mm_shuffle_ps( p0, p1, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+		_mm_storeu_ps( out + i, _mm_sub_ps( lhs, rhs ) );
+	}
+	vec2_cross_scalar( out, a, b, n, i );
+}
+
+inline void vec2_magnitude_sse2( float * out, float const * a, int n ) {
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m128 a0 = _mm_loadu_ps( a + 2*i ), a1 = _mm_loadu_ps( a + 2*i + 4 );
+		__m128 p0 = _mm_mul_ps( a0, a0 ), p1 = _mm_mul_ps( a1, a1 );
+		__m128 xs = _mm_shuffle_ps( p0, p1, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		__m128 ys = _mm_shuffle_ps( p0, p1, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+		_mm_storeu_ps( out + i, _mm_sqrt_ps( _mm_add_ps( xs, ys ) ) );
+	}
+	vec2_magnitude_scalar( out, a, n, i );
+}
+
+inline void vec2_normalize_sse2( float * dst, float const * a, int n ) {
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		__m128 v = _mm_loadu_ps( a + 2*i );
+		__m128 p = _mm_mul_ps( v, v );
+		// 每个向量的两个分量上都得到 x*x + y*y
+		__m128 len = _mm_sqrt_ps( _mm_add_ps( p, _mm_shuffle_ps( p, p, _MM_SHUFFLE( 2, 3, 0, 1 ) ) ) );
+		_mm_storeu_ps( dst + 2*i, _mm_div_ps( v, len ) );
+	}
+	vec2_normalize_scalar( dst, a, n, i );
+}
+
+inline void vec2_rotate_sse2( float * dst, float const * a, float s, float c, int n ) {
+	__m128 vc = _mm_set1_ps( c );
+	__m128 vs = _mm_setr_ps( -s, s, -s, s );
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		__m128 v = _mm_loadu_ps( a + 2*i );
+		__m128 w = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+		_mm_storeu_ps( dst + 2*i, _mm_add_ps( _mm_mul_ps( v, vc ), _mm_mul_ps( w, vs ) ) );
+	}
+	vec2_rotate_scalar( dst, a, s, c, n, i );
+}
+
+inline void vec2_add_sse2( double * dst, double const * a, double const * b, int n ) {
+	for( int i=0; i<n; ++i ) {
+		_mm_storeu_pd( dst + 2*i, _mm_add_pd( _mm_loadu_pd( a + 2*i ), _mm_loadu_pd( b + 2*i ) ) );
+	}
+}
+
+inline void vec2_scale_sse2( double * dst, double const * a, double k, int n ) {
+	__m128d vk = _mm_set1_pd( k );
+	for( int i=0; i<n; ++i ) {
+		_mm_storeu_pd( dst + 2*i, _mm_mul_pd( _mm_loadu_pd( a + 2*i ), vk ) );
+	}
+}
+
+inline void vec2_dot_sse2( double * out, double const * a, double const * b, int n ) {
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		__m128d p0 = _mm_mul_pd( _mm_loadu_pd( a + 2*i ), _mm_loadu_pd( b + 2*i ) );
+		__m128d p1 = _mm_mul_pd( _mm_loadu_pd( a + 2*i + 2 ), _mm_loadu_pd( b + 2*i + 2 ) );
+		_mm_storeu_pd( out + i, _mm_add_pd( _mm_unpacklo_pd( p0, p1 ), _mm_unpackhi_pd( p0, p1 ) ) );
+	}
+	vec2_dot_scalar( out, a, b, n, i );
+}
+
+inline void vec2_cross_sse2( double * out, double const * a, double const * b, int n ) {
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		__m128d b0 = _mm_loadu_pd( b + 2*i ), b1 = _mm_loadu_pd( b + 2*i + 2 );
+		__m128d p0 = _mm_mul_pd( _mm_loadu_pd( a + 2*i ), _mm_shuffle_pd( b0, b0, 1 ) );
+		__m128d p1 = _mm_mul_pd( _mm_loadu_pd( a + 2*i + 2 ), _mm_shuffle_pd( b1, b1, 1 ) );
+		_mm_storeu_pd( out + i, _mm_sub_pd( _mm_unpacklo_pd( p0, p1 ), _mm_unpackhi_pd( p0, p1 ) ) );
+	}
+	vec2_cross_scalar( out, a, b, n, i );
+}
+
+inline void vec2_magnitude_sse2( double * out, double const * a, int n ) {
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		__m128d a0 = _mm_loadu_pd( a + 2*i ), a1 = _mm_loadu_pd( a + 2*i + 2 );
+		__m128d p0 = _mm_mul_pd( a0, a0 ), p1 = _mm_mul_pd( a1, a1 );
+		_mm_storeu_pd( out + i, _mm_sqrt_pd( _mm_add_pd( _mm_unpacklo_pd( p0, p1 ), _mm_unpackhi_pd( p0, p1 ) ) ) );
+	}
+	vec2_magnitude_scalar( out, a, n, i );
+}
+
+inline void vec2_normalize_sse2( double * dst, double const * a, int n ) {
+	for( int i=0; i<n; ++i ) {
+		__m128d v = _mm_loadu_pd( a + 2*i );
+		__m128d p = _mm_mul_pd( v, v );
+		__m128d len = _mm_sqrt_pd( _mm_add_pd( p, _mm_shuffle_pd( p, p, 1 ) ) );
+		_mm_storeu_pd( dst + 2*i, _mm_div_pd( v, len ) );
+	}
+}
+
+inline void vec2_rotate_sse2( double * dst, double const * a, double s, double c, int n ) {
+	__m128d vc = _mm_set1_pd( c );
+	__m128d vs = _mm_setr_pd( -s, s );
+	for( int i=0; i<n; ++i ) {
+		__m128d v = _mm_loadu_pd( a + 2*i );
+		_mm_storeu_pd( dst + 2*i, _mm_add_pd( _mm_mul_pd( v, vc ), _mm_mul_pd( _mm_shuffle_pd( v, v, 1 ), vs ) ) );
+	}
+}
+
+/*
+ *  AVX2 版本：一个 float 寄存器放 4 个向量，一个 double 寄存器放 2 个向量。
+ *  256 位的 shuffle/unpack 只在各自的 128 位半边内进行，归约后用 permute4x64 恢复顺序
+ */
+BR_TARGET_AVX2 inline __m256 vec2_merge_avx2( __m256 even, __m256 odd, bool subtract ) {
+	__m256 r = subtract ? _mm256_sub_ps( even, odd ) : _mm256_add_ps( even, odd );
+	return _mm256_castpd_ps( _mm256_permute4x64_pd( _mm256_castps_pd( r ), _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+}
+
+BR_TARGET_AVX2 inline void vec2_add_avx2( float * dst, float const * a, float const * b, int n ) {
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		_mm256_storeu_ps( dst + 2*i, _mm256_add_ps( _mm256_loadu_ps( a + 2*i ), _mm256_loadu_ps( b + 2*i ) ) );
+	}
+	vec2_add_scalar( dst, a, b, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_scale_avx2( float * dst, float const * a, float k, int n ) {
+	__m256 vk = _mm256_set1_ps( k );
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		_mm256_storeu_ps( dst + 2*i, _mm256_mul_ps( _mm256_loadu_ps( a + 2*i ), vk ) );
+	}
+	vec2_scale_scalar( dst, a, k, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_dot_avx2( float * out, float const * a, float const * b, int n ) {
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		__m256 p0 = _mm256_mul_ps( _mm256_loadu_ps( a + 2*i ), _mm256_loadu_ps( b + 2*i ) );
+		__m256 p1 = _mm256_mul_ps( _mm256_loadu_ps( a + 2*i + 8 ), _mm256_loadu_ps( b + 2*i + 8 ) );
+		__m256 xs = _mm256_shuffle_ps( p0, p1, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		__m256 ys = _mm256_shuffle_ps( p0, p1, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+		_mm256_storeu_ps( out + i, vec2_merge_avx2( xs, ys, false ) );
+	}
+	vec2_dot_scalar( out, a, b, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_cross_avx2( float * out, float const * a, float const * b, int n ) {
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		__m256 p0 = _mm256_mul_ps( _mm256_loadu_ps( a + 2*i ), _mm256_permute_ps( _mm256_loadu_ps( b + 2*i ), _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		__m256 p1 = _mm256_mul_ps( _mm256_loadu_ps( a + 2*i + 8 ), _mm256_permute_ps( _mm256_loadu_ps( b + 2*i + 8 ), _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		__m256 lhs = _mm256_shuffle_ps( p0, p1, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		__m256 rhs = _mm256_shuffle_ps( p0, p1, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+		_mm256_storeu_ps( out + i, vec2_merge_avx2( lhs, rhs, true ) );
+	}
+	vec2_cross_scalar( out, a, b, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_magnitude_avx2( float * out, float const * a, int n ) {
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		__m256 a0 = _mm256_loadu_ps( a + 2*i ), a1 = _mm256_loadu_ps( a + 2*i + 8 );
+		__m256 p0 = _mm256_mul_ps( a0, a0 ), p1 = _mm256_mul_ps( a1, a1 );
+		__m256 xs = _mm256_shuffle_ps( p0, p1, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		__m256 ys = _mm256_shuffle_ps( p0, p1, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+		_mm256_storeu_ps( out + i, _mm256_sqrt_ps( vec2_merge_avx2( xs, ys, false ) ) );
+	}
+	vec2_magnitude_scalar( out, a, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_normalize_avx2( float * dst, float const * a, int n ) {
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m256 v = _mm256_loadu_ps( a + 2*i );
+		__m256 p = _mm256_mul_ps( v, v );
+		__m256 len = _mm256_sqrt_ps( _mm256_add_ps( p, _mm256_permute_ps( p, _MM_SHUFFLE( 2, 3, 0, 1 ) ) ) );
+		_mm256_storeu_ps( dst + 2*i, _mm256_div_ps( v, len ) );
+	}
+	vec2_normalize_scalar( dst, a, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_rotate_avx2( float * dst, float const * a, float s, float c, int n ) {
+	__m256 vc = _mm256_set1_ps( c );
+	__m256 vs = _mm256_setr_ps( -s, s, -s, s, -s, s, -s, s );
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m256 v = _mm256_loadu_ps( a + 2*i );
+		__m256 w = _mm256_permute_ps( v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+		_mm256_storeu_ps( dst + 2*i, _mm256_add_ps( _mm256_mul_ps( v, vc ), _mm256_mul_ps( w, vs ) ) );
+	}
+	vec2_rotate_scalar( dst, a, s, c, n, i );
+}
+
+BR_TARGET_AVX2 inline __m256d vec2_merge_avx2( __m256d even, __m256d odd, bool subtract ) {
+	__m256d r = subtract ? _mm256_sub_pd( even, odd ) : _mm256_add_pd( even, odd );
+	return _mm256_permute4x64_pd( r, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+}
+
+BR_TARGET_AVX2 inline void vec2_add_avx2( double * dst, double const * a, double const * b, int n ) {
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		_mm256_storeu_pd( dst + 2*i, _mm256_add_pd( _mm256_loadu_pd( a + 2*i ), _mm256_loadu_pd( b + 2*i ) ) );
+	}
+	vec2_add_scalar( dst, a, b, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_scale_avx2( double * dst, double const * a, double k, int n ) {
+	__m256d vk = _mm256_set1_pd( k );
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		_mm256_storeu_pd( dst + 2*i, _mm256_mul_pd( _mm256_loadu_pd( a + 2*i ), vk ) );
+	}
+	vec2_scale_scalar( dst, a, k, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_dot_avx2( double * out, double const * a, double const * b, int n ) {
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m256d p0 = _mm256_mul_pd( _mm256_loadu_pd( a + 2*i ), _mm256_loadu_pd( b + 2*i ) );
+		__m256d p1 = _mm256_mul_pd( _mm256_loadu_pd( a + 2*i + 4 ), _mm256_loadu_pd( b + 2*i + 4 ) );
+		_mm256_storeu_pd( out + i, vec2_merge_avx2( _mm256_unpacklo_pd( p0, p1 ), _mm256_unpackhi_pd( p0, p1 ), false ) );
+	}
+	vec2_dot_scalar( out, a, b, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_cross_avx2( double * out, double const * a, double const * b, int n ) {
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m256d p0 = _mm256_mul_pd( _mm256_loadu_pd( a + 2*i ), _mm256_permute_pd( _mm256_loadu_pd( b + 2*i ), 5 ) );
+		__m256d p1 = _mm256_mul_pd( _mm256_loadu_pd( a + 2*i + 4 ), _mm256_permute_pd( _mm256_loadu_pd( b + 2*i + 4 ), 5 ) );
+		_mm256_storeu_pd( out + i, vec2_merge_avx2( _mm256_unpacklo_pd( p0, p1 ), _mm256_unpackhi_pd( p0, p1 ), true ) );
+	}
+	vec2_cross_scalar( out, a, b, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_magnitude_avx2( double * out, double const * a, int n ) {
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m256d a0 = _mm256_loadu_pd( a + 2*i ), a1 = _mm256_loadu_pd( a + 2*i + 4 );
+		__m256d p0 = _mm256_mul_pd( a0, a0 ), p1 = _mm256_mul_pd( a1, a1 );
+		_mm256_storeu_pd( out + i, _mm256_sqrt_pd( vec2_merge_avx2( _mm256_unpacklo_pd( p0, p1 ), _mm256_unpackhi_pd( p0, p1 ), false ) ) );
+	}
+	vec2_magnitude_scalar( out, a, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_normalize_avx2( double * dst, double const * a, int n ) {
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		__m256d v = _mm256_loadu_pd( a + 2*i );
+		__m256d p = _mm256_mul_pd( v, v );
+		__m256d len = _mm256_sqrt_pd( _mm256_add_pd( p, _mm256_permute_pd( p, 5 ) ) );
+		_mm256_storeu_pd( dst + 2*i, _mm256_div_pd( v, len ) );
+	}
+	vec2_normalize_scalar( dst, a, n, i );
+}
+
+BR_TARGET_AVX2 inline void vec2_rotate_avx2( double * dst, double const * a, double s, double c, int n ) {
+	__m256d vc = _mm256_set1_pd( c );
+	__m256d vs = _mm256_setr_pd( -s, s, -s, s );
+	int i = 0;
+	for( ; i+2<=n; i+=2 ) {
+		__m256d v = _mm256_loadu_pd( a + 2*i );
+		_mm256_storeu_pd( dst + 2*i, _mm256_add_pd( _mm256_mul_pd( v, vc ), _mm256_mul_pd( _mm256_permute_pd( v, 5 ), vs ) ) );
+	}
+	vec2_rotate_scalar( dst, a, s, c, n, i );
+}
+#endif // BR_HAS_X86_SIMD
+
+/*
+ *  按分量类型选择实现：float、double 按运行时指令集分派，其他类型使用标量循环
+ */
+template< class Tp >
+struct Vec2Bulk {
+	static void add( Tp * dst, Tp const * a, Tp const * b, int n ) {
+		vec2_add_scalar( dst, a, b, n );
+	}
+
+	static void scale( Tp * dst, Tp const * a, Tp k, int n ) {
+		vec2_scale_scalar( dst, a, k, n );
+	}
+
+	static void dot( Tp * out, Tp const * a, Tp const * b, int n ) {
+		vec2_dot_scalar( out, a, b, n );
+	}
+
+	static void cross( Tp * out, Tp const * a, Tp const * b, int n ) {
+		vec2_cross_scalar( out, a, b, n );
+	}
+
+	static void magnitude( Tp * out, Tp const * a, int n ) {
+		vec2_magnitude_scalar( out, a, n );
+	}
+
+	static void normalize( Tp * dst, Tp const * a, int n ) {
+		vec2_normalize_scalar( dst, a, n );
+	}
+
+	static void rotate( Tp * dst, Tp const * a, Tp s, Tp c, int n ) {
+		vec2_rotate_scalar( dst, a, s, c, n );
+	}
+};
+
+#ifdef BR_HAS_X86_SIMD
+#	define BR_VEC2_DISPATCH( name, ... ) \
+	return simd::has_avx2() ? vec2_##name##_avx2( __VA_ARGS__ ) : vec2_##name##_sse2( __VA_ARGS__ )
+
+template< class Tp >
+struct Vec2BulkSIMD {
+	static void add( Tp * dst, Tp const * a, Tp const * b, int n ) {
+		BR_VEC2_DISPATCH( add, dst, a, b, n );
+	}
+
+	static void scale( Tp * dst, Tp const * a, Tp k, int n ) {
+		BR_VEC2_DISPATCH( scale, dst, a, k, n );
+	}
+
+	static void dot( Tp * out, Tp const * a, Tp const * b, int n ) {
+		BR_VEC2_DISPATCH( dot, out, a, b, n );
+	}
+
+	static void cross( Tp * out, Tp const * a, Tp const * b, int n ) {
+		BR_VEC2_DISPATCH( cross, out, a, b, n );
+	}
+
+	static void magnitude( Tp * out, Tp const * a, int n ) {
+		BR_VEC2_DISPATCH( magnitude, out, a, n );
+	}
+
+	static void normalize( Tp * dst, Tp const * a, int n ) {
+		BR_VEC2_DISPATCH( normalize, dst, a, n );
+	}
+
+	static void rotate( Tp * dst, Tp const * a, Tp s, Tp c, int n ) {
+		BR_VEC2_DISPATCH( rotate, dst, a, s, c, n );
+	}
+};
+
+#	undef BR_VEC2_DISPATCH
+
+template<>
+struct Vec2Bulk< float > : Vec2BulkSIMD< float > {
+};
+
+template<>
+struct Vec2Bulk< double > : Vec2BulkSIMD< double > {
+};
+#endif // BR_HAS_X86_SIMD
+
+/*
+ *  把 Vector2D 数组看作交错存放的分量数组
+ */
+template< class Vec >
+struct Vec2Layout {
+	typedef typename Vec::value_type Tp;
+
+	static_assert( sizeof(Vec) == 2 * sizeof(Tp), "Vec must hold exactly x and y" );
+
+	static Tp * comp( Vec * v ) {
+		return (Tp *)v;
+	}
+
+	static Tp const * comp( Vec const * v ) {
+		return (Tp const *)v;
+	}
+};
+
+} // namespace detail
+
+/*
+ *  @brief Vector2D 数组的批量运算
+ *
+ *  Vec 可以是 Vector2D<Tp>、Point2D<Tp> 或 XYPair<Tp>，只要求按 x、y 顺序紧密存放；
+ *  n 为向量个数，输出可以与输入是同一数组。
+ *  float 与 double 有 SSE2/AVX2 实现，按运行时检测到的指令集分派，结果与标量版本逐位一致。
+ *  vec2_normalize 与 Vector2D::unitize 一样直接除以长度，零向量得到 NaN。
+ */
+template< class Vec >
+inline void vec2_add( Vec * dst, Vec const * a, Vec const * b, int n ) {
+	typedef detail::Vec2Layout< Vec > L;
+	detail::Vec2Bulk< typename L::Tp >::add( L::comp( dst ), L::comp( a ), L::comp( b ), n );
+}
+
+template< class Vec >
+inline void vec2_scale( Vec * dst, Vec const * a, typename Vec::value_type k, int n ) {
+	typedef detail::Vec2Layout< Vec > L;
+	detail::Vec2Bulk< typename L::Tp >::scale( L::comp( dst ), L::comp( a ), k, n );
+}
+
+/*
+ *  out[i] = a[i] 与 b[i] 的点积
+ */
+template< class Vec >
+inline void vec2_dot( typename Vec::value_type * out, Vec const * a, Vec const * b, int n ) {
+	typedef detail::Vec2Layout< Vec > L;
+	detail::Vec2Bulk< typename L::Tp >::dot( out, L::comp( a ), L::comp( b ), n );
+}
+
+/*
+ *  out[i] = a[i].x * b[i].y - a[i].y * b[i].x
+ */
+template< class Vec >
+inline void vec2_cross( typename Vec::value_type * out, Vec const * a, Vec const * b, int n ) {
+	typedef detail::Vec2Layout< Vec > L;
+	detail::Vec2Bulk< typename L::Tp >::cross( out, L::comp( a ), L::comp( b ), n );
+}
+
+template< class Vec >
+inline void vec2_magnitude( typename Vec::value_type * out, Vec const * a, int n ) {
+	typedef detail::Vec2Layout< Vec > L;
+	detail::Vec2Bulk< typename L::Tp >::magnitude( out, L::comp( a ), n );
+}
+
+template< class Vec >
+inline void vec2_normalize( Vec * dst, Vec const * a, int n ) {
+	typedef detail::Vec2Layout< Vec > L;
+	detail::Vec2Bulk< typename L::Tp >::normalize( L::comp( dst ), L::comp( a ), n );
+}
+
+/*
+ *  逆时针旋转 angle 弧度，同 Vector2D::rotate
+ */
+template< class Vec >
+inline void vec2_rotate( Vec * dst, Vec const * a, typename Vec::value_type angle, int n ) {
+	typedef detail::Vec2Layout< Vec > L;
+	detail::Vec2Bulk< typename L::Tp >::rotate( L::comp( dst ), L::comp( a ), std::sin( angle ), std::cos( angle ), n );
+}
+
+}
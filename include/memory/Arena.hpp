@@ -0,0 +1,273 @@
+﻿/*
+ * @file  include/memory/Arena.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <memory/MemPoolBase.hpp>
+
+namespace BR {
+/*
+ *  @brief 单调（bump-pointer）内存区
+ *
+ *  从链在一起的块中顺序切出任意大小、任意对齐的内存，不能单独释放，
+ *  reset() 一次性作废全部分配。reset 后保留已有的块供下一轮复用，
+ *  因此稳定运行时不再向系统申请内存；release() 才真正归还堆上的块。
+ *  可以把调用者提供的缓冲区（如栈上数组，见 InlineArena）作为第一块。非线程安全。
+ */
+class Arena {
+public:
+	explicit Arena( std::size_t block_size = 4096 ) :
+		m_first( BR_NULLPTR ), m_curr( BR_NULLPTR ), m_ptr( BR_NULLPTR ), m_end( BR_NULLPTR ),
+		m_block_size( block_size ), m_inline( false ) { }
+
+	/*
+	 *  以 buffer 作为第一块，buffer 的生存期必须覆盖 Arena
+	 */
+	Arena( void * buffer, std::size_t bytes, std::size_t block_size = 4096 ) :
+		m_first( BR_NULLPTR ), m_curr( BR_NULLPTR ), m_ptr( BR_NULLPTR ), m_end( BR_NULLPTR ),
+		m_block_size( block_size ), m_inline( false ) {
+		if ( bytes > sizeof(Block) ) {
+			m_first = new( buffer ) Block();
+			m_first->next = BR_NULLPTR;
+			m_first->size = bytes;
+			m_inline = true;
+			enter( m_first );
+		}
+	}
+
+	~Arena() {
+		release();
+	}
+
+	void * allocate( std::size_t bytes, std::size_t align = alignof(std::max_align_t) ) {
+		BR_ASSERT( align != 0 && ( align & ( align - 1 ) ) == 0 );
+		char * mem = align_up( m_ptr, align );
+		if ( m_ptr == BR_NULLPTR || mem + bytes > m_end ) {
+			mem = grow( bytes, align );
+		}
+		m_ptr = mem + bytes;
+		return mem;
+	}
+
+	template< class Tp >
+	Tp * allocate_array( std::size_t n ) {
+		return (Tp *)allocate( sizeof(Tp) * n, alignof(Tp) );
+	}
+
+	/*
+	 *  作废全部分配，保留块供复用
+	 */
+	void reset() {
+		if ( m_first != BR_NULLPTR ) {
+			enter( m_first );
+		}
+	}
+
+	/*
+	 *  作废全部分配并归还堆上的块，只保留调用者提供的第一块
+	 */
+	void release() {
+		Block * block = m_inline ? m_first->next : m_first;
+		while ( block != BR_NULLPTR ) {
+			Block * next = block->next;
+			::operator delete( block );
+			block = next;
+		}
+		if ( m_inline ) {
+			m_first->next = BR_NULLPTR;
+			enter( m_first );
+		} else {
+			m_first = m_curr = BR_NULLPTR;
+			m_ptr = m_end = BR_NULLPTR;
+		}
+	}
+
+	/*
+	 *  当前块之前的块与当前块已用部分的字节数（含对齐填充）
+	 */
+	std::size_t used() const {
+		std::size_t result = 0;
+		for( Block * block = m_first; block != m_curr; block = block->next ) {
+			result += (char *)block + block->size - data( block );
+		}
+		if ( m_curr != BR_NULLPTR ) {
+			result += m_ptr - data( m_curr );
+		}
+		return result;
+	}
+
+	std::size_t reserved() const {
+		std::size_t result = 0;
+		for( Block * block = m_first; block != BR_NULLPTR; block = block->next ) {
+			result += block->size;
+		}
+		return result;
+	}
+
+private:
+	Arena( Arena const & );
+	Arena & operator=( Arena const & );
+
+	struct Block {
+		Block *            next;
+		std::size_t        size;   // 含块头的总字节数
+		std::max_align_t   align;
+	};
+
+	static char * data( Block * block ) {
+		return (char *)&block->align;
+	}
+
+	static char * align_up( char * ptr, std::size_t align ) {
+		return (char *)( ( (std::size_t)ptr + align - 1 ) & ~( align - 1 ) );
+	}
+
+	void enter( Block * block ) {
+		m_curr = block;
+		m_ptr = data( block );
+		m_end = (char *)block + block->size;
+	}
+
+	char * grow( std::size_t bytes, std::size_t align ) {
+		// 先尝试 reset 之后留下的后续块
+		while ( m_curr != BR_NULLPTR && m_curr->next != BR_NULLPTR ) {
+			enter( m_curr->next );
+			char * mem = align_up( m_ptr, align );
+			if ( mem + bytes <= m_end ) {
+				return mem;
+			}
+		}
+		std::size_t need = sizeof(Block) + bytes + align;
+		std::size_t size = need > m_block_size ? need : m_block_size;
+		Block * block = (Block *)::operator new( size );
+		block->next = BR_NULLPTR;
+		block->size = size;
+		if ( m_curr == BR_NULLPTR ) {
+			m_first = block;
+		} else {
+			m_curr->next = block;
+		}
+		enter( block );
+		return align_up( m_ptr, align );
+	}
+
+	Block *     m_first;
+	Block *     m_curr;
+	char *      m_ptr;
+	char *      m_end;
+	std::size_t m_block_size;
+	bool        m_inline;
+};
+
+namespace detail {
+
+template< std::size_t N >
+struct InlineArenaBuffer {
+	typename std::aligned_storage< N, alignof(std::max_align_t) >::type buffer;
+};
+
+} // namespace detail
+
+/*
+ *  @brief 自带 N 字节内联首块的 Arena，放在栈上时首块不需要堆分配
+ *
+ *  缓冲区放在先于 Arena 构造的基类中，保证 Arena 构造时它已经存在
+ */
+template< std::size_t N, std::size_t BLOCK_SIZE = 4096 >
+class InlineArena : private detail::InlineArenaBuffer< N >, public Arena {
+public:
+	InlineArena() : detail::InlineArenaBuffer< N >(), Arena( &this->buffer, N, BLOCK_SIZE ) { }
+};
+
+/*
+ *  @brief 以 Arena 为后端的 DynArrPOD 等容器的分配器
+ *
+ *  deallocate 什么也不做，内存随 Arena::reset() 一起回收
+ */
+class ArenaRawAlloc {
+public:
+	explicit ArenaRawAlloc( Arena & arena ) : m_arena( &arena ) { }
+
+	void * allocate( std::size_t bytes ) {
+		return m_arena->allocate( bytes );
+	}
+
+	void deallocate( void *, std::size_t ) { }
+
+	void * reallocate( void * mem, std::size_t, std::size_t new_bytes, std::size_t used_bytes ) {
+		void * new_mem = m_arena->allocate( new_bytes );
+		memcpy( new_mem, mem, used_bytes );
+		return new_mem;
+	}
+
+private:
+	Arena * m_arena;
+};
+
+/*
+ *  @brief 以 Arena 为后端的定长内存池
+ *
+ *  释放的项挂入本地空闲链表供再次分配；Arena::reset() 之后必须先调用 clear()。
+ */
+template< int SIZE >
+class ArenaMemPool : public MemPoolBase {
+public:
+	explicit ArenaMemPool( Arena & arena ) : m_arena( &arena ), m_root( BR_NULLPTR ), m_curr_alloc( 0 ) { }
+
+	virtual int item_size() const {
+		return SIZE;
+	}
+
+	virtual void * alloc() {
+		++m_curr_alloc;
+		if ( m_root != BR_NULLPTR ) {
+			Chunk * chunk = m_root;
+			m_root = chunk->next;
+			return chunk;
+		}
+		return m_arena->allocate( sizeof(Chunk), alignof(Chunk) );
+	}
+
+	virtual void free( void * mem ) {
+		if ( !mem ) {
+			return;
+		}
+		--m_curr_alloc;
+		Chunk * chunk = (Chunk *)mem;
+		chunk->next = m_root;
+		m_root = chunk;
+	}
+
+	virtual void track() { }
+
+	int curr_alloc() const {
+		return m_curr_alloc;
+	}
+
+	void clear() {
+		m_root = BR_NULLPTR;
+		m_curr_alloc = 0;
+	}
+
+private:
+	ArenaMemPool( ArenaMemPool const & );
+	ArenaMemPool & operator=( ArenaMemPool const & );
+
+	union Chunk {
+		Chunk * next;
+		char    mem[SIZE];
+	};
+
+	Arena * m_arena;
+	Chunk * m_root;
+	int     m_curr_alloc;
+};
+
+}
@@ -0,0 +1,132 @@
+﻿/*
+ * @file  include/memory/BlockPolicy.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <cstddef>
+#include <new>
+
+#ifdef BR_HAS_MMAP
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif // BR_HAS_MMAP
+
+namespace BR {
+namespace detail {
+/*
+ *  空闲链表中每项实际占用的字节数：至少放得下一个指针，并按指针对齐
+ */
+template< int SIZE >
+struct ChunkStride {
+	static int const PTR = (int)sizeof(void *);
+	static int const value = SIZE < PTR ? PTR : ( SIZE + PTR - 1 ) / PTR * PTR;
+};
+
+/*
+ *  BYTES 字节的块扣除 HEADER 字节的块头后能容纳的项数，至少 MIN_COUNT 项
+ */
+template< int BYTES, int MIN_COUNT, int SIZE, int HEADER >
+struct BlockCount {
+	static int const ROOM = ( BYTES - HEADER ) / ChunkStride< SIZE >::value;
+	static int const value = ROOM < MIN_COUNT ? MIN_COUNT : ROOM;
+};
+
+} // namespace detail
+
+/*
+ *  @brief 内存池块策略：块从普通堆上分配
+ *  @param  BYTES      每块的目标字节数
+ *  @param  MIN_COUNT  每块至少容纳的项数，项较大时块会超过 BYTES
+ *
+ *  内存池以 Count< SIZE, HEADER > 决定每块项数：按项在链表中的实际跨度计算，
+ *  并扣除池放在块内的 HEADER 字节，因此只要不受 MIN_COUNT 限制，整块不超过 BYTES。
+ */
+template< int BYTES = 4*1024, int MIN_COUNT = 8 >
+struct HeapBlockPolicy {
+	static int const BLOCK_BYTES = BYTES;
+	static int const BLOCK_MIN_COUNT = MIN_COUNT;
+
+	template< int SIZE, int HEADER = 0 >
+	struct Count : detail::BlockCount< BYTES, MIN_COUNT, SIZE, HEADER > {
+	};
+
+	static void * allocate( std::size_t bytes ) {
+		return ::operator new( bytes );
+	}
+
+	static void deallocate( void * mem, std::size_t ) {
+		::operator delete( mem );
+	}
+};
+
+/*
+ *  @brief 内存池块策略：块由 2 MiB 大页承载
+ *  @param  BYTES      每块的目标字节数，默认正好一个大页
+ *  @param  MIN_COUNT  每块至少容纳的项数
+ *
+ *  优先使用 MAP_HUGETLB 预留的大页；没有预留时退回按 2 MiB 对齐的普通映射并
+ *  以 MADV_HUGEPAGE 请求透明大页。不支持 mmap 的平台上等同于 HeapBlockPolicy。
+ */
+template< int BYTES = 2*1024*1024, int MIN_COUNT = 8 >
+struct HugePageBlockPolicy {
+	static int const BLOCK_BYTES = BYTES;
+	static int const BLOCK_MIN_COUNT = MIN_COUNT;
+
+	template< int SIZE, int HEADER = 0 >
+	struct Count : detail::BlockCount< BYTES, MIN_COUNT, SIZE, HEADER > {
+	};
+
+	static std::size_t const HUGE_PAGE = 2*1024*1024;
+
+#ifdef BR_HAS_MMAP
+	static void * allocate( std::size_t bytes ) {
+		std::size_t len = round_up( bytes );
+#ifdef MAP_HUGETLB
+		void * mem = mmap( BR_NULLPTR, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+		if ( mem != MAP_FAILED ) {
+			return mem;
+		}
+#endif // MAP_HUGETLB
+		// 多映射一个大页，裁掉首尾使起始地址按大页对齐
+		char * raw = (char *)mmap( BR_NULLPTR, len + HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+		if ( raw == (char *)MAP_FAILED ) {
+			throw std::bad_alloc();
+		}
+		char * aligned = (char *)( ( (std::size_t)raw + HUGE_PAGE - 1 ) & ~( HUGE_PAGE - 1 ) );
+		if ( aligned != raw ) {
+			munmap( raw, aligned - raw );
+		}
+		std::size_t tail = ( raw + len + HUGE_PAGE ) - ( aligned + len );
+		if ( tail != 0 ) {
+			munmap( aligned + len, tail );
+		}
+#ifdef MADV_HUGEPAGE
+		madvise( aligned, len, MADV_HUGEPAGE );
+#endif // MADV_HUGEPAGE
+		return aligned;
+	}
+
+	static void deallocate( void * mem, std::size_t bytes ) {
+		munmap( mem, round_up( bytes ) );
+	}
+#else
+	static void * allocate( std::size_t bytes ) {
+		return ::operator new( bytes );
+	}
+
+	static void deallocate( void * mem, std::size_t ) {
+		::operator delete( mem );
+	}
+#endif // BR_HAS_MMAP
+
+private:
+	static std::size_t round_up( std::size_t bytes ) {
+		return ( bytes + HUGE_PAGE - 1 ) & ~( HUGE_PAGE - 1 );
+	}
+};
+
+typedef HeapBlockPolicy<> DefaultBlockPolicy;
+
+}
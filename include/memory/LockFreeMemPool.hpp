@@ -0,0 +1,241 @@
+﻿/*
+ * @file  include/memory/LockFreeMemPool.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include HEADER_STDINT
+
+#include <memory/BlockPolicy.hpp>
+#include <memory/MemPoolBase.hpp>
+
+namespace BR {
+/*
+ *  @brief 无锁内存池
+ *
+ *  空闲链表是一个 Treiber 栈，栈顶 m_root 把指针和 16 位版本号打包进
+ *  一个 64 位字，每次修改都递增版本号以避免 ABA 问题。
+ *  版本号每 65536 次修改回绕一次：若某线程在读取栈顶与 CAS 之间被挂起，期间
+ *  恰好发生 65536 的整数倍次修改且栈顶回到同一节点，ABA 仍会发生。
+ *  要求块地址不超过 48 位，新块不满足时（如 57 位地址或带标记的指针）抛出 std::runtime_error。
+ *  块只在析构时释放，因此弹栈时读取已被其他线程取走的节点的 next 是安全的，
+ *  读到的旧值会因版本号不符而被 CAS 丢弃。
+ *  新块由取空链表的线程独占切分，除第一项外整段一次性压入栈中；块链表同样无锁。
+ */
+template< int SIZE, class Policy = DefaultBlockPolicy >
+class LockFreeMemPool : public MemPoolBase {
+public:
+	LockFreeMemPool() :
+		m_root( 0 ), m_blocks( BR_NULLPTR ), m_curr_alloc( 0 ), m_have_alloc( 0 ), m_untracked( 0 ) { }
+
+	~LockFreeMemPool() {
+		// Delete the blocks.
+		Block * block = m_blocks.load( std::memory_order_acquire );
+		while ( block != BR_NULLPTR ) {
+			Block * next = block->next;
+			Policy::deallocate( block, sizeof(Block) );
+			block = next;
+		}
+	}
+
+	virtual int item_size() const {
+		return SIZE;
+	}
+
+	int curr_alloc() const {
+		return m_curr_alloc.load( std::memory_order_relaxed );
+	}
+
+	long long have_alloc() const {
+		return m_have_alloc.load( std::memory_order_relaxed );
+	}
+
+	virtual void * alloc() {
+		Chunk * chunk = pop();
+		if ( chunk == BR_NULLPTR ) {
+			void * mem;
+			carve( &mem, 1 );
+			chunk = (Chunk *)mem;
+		}
+		count_alloc( 1 );
+		return chunk;
+	}
+
+	virtual void alloc_n( void ** out, int n ) {
+		int i = 0;
+		while ( i < n ) {
+			Chunk * chunk = pop();
+			if ( chunk == BR_NULLPTR ) {
+				break;
+			}
+			out[i++] = chunk;
+		}
+		while ( i < n ) {
+			i += carve( out + i, n - i );
+		}
+		count_alloc( n );
+	}
+
+	virtual void free( void * mem ) {
+		if ( !mem ) {
+			return;
+		}
+		m_curr_alloc.fetch_sub( 1, std::memory_order_relaxed );
+		Chunk * chunk = (Chunk *)mem;
+#ifndef NDEBUG
+		memset( chunk, 0xFE, sizeof(Chunk) );
+#endif
+		push( chunk, chunk );
+	}
+
+	virtual void free_n( void * const * in, int n ) {
+		// 先在本地串成一段，再用一次 CAS 整段压栈
+		Chunk * first = BR_NULLPTR;
+		Chunk * last = BR_NULLPTR;
+		int freed = 0;
+		for( int i=0; i<n; ++i ) {
+			if ( !in[i] ) {
+				continue;
+			}
+			Chunk * chunk = (Chunk *)in[i];
+#ifndef NDEBUG
+			memset( chunk, 0xFE, sizeof(Chunk) );
+#endif
+			chunk->next = first;
+			first = chunk;
+			if ( last == BR_NULLPTR ) {
+				last = chunk;
+			}
+			++freed;
+		}
+		if ( freed != 0 ) {
+			m_curr_alloc.fetch_sub( freed, std::memory_order_relaxed );
+			push( first, last );
+		}
+	}
+
+	virtual void track() {
+		m_untracked.fetch_sub( 1, std::memory_order_relaxed );
+	}
+
+	int untracked() const {
+		return m_untracked.load( std::memory_order_relaxed );
+	}
+
+	/*
+	 *  各计数分别读取，并发修改时快照不是严格一致的；不记录峰值
+	 */
+	virtual void stats( MemPoolStats & out ) const {
+		out = MemPoolStats();
+		out.item_size = SIZE;
+		out.items_per_block = COUNT;
+		out.curr_alloc = curr_alloc();
+		out.max_alloc = -1;
+		out.have_alloc = have_alloc();
+		out.untracked = untracked();
+		for( Block * block = m_blocks.load( std::memory_order_acquire ); block != BR_NULLPTR; block = block->next ) {
+			++out.blocks;
+		}
+		out.bytes_reserved = (long long)out.blocks * sizeof(Block);
+		out.bytes_in_use = (long long)out.curr_alloc * SIZE;
+	}
+
+	// 块末尾的 next 指针计入块头，整块才能放进策略给定的字节数
+	static int const COUNT = Policy::template Count< SIZE, sizeof(void *) >::value;
+
+private:
+	union Chunk {
+		Chunk * next;
+		char    mem[SIZE];
+	};
+
+	struct Block {
+		Chunk   chunk[COUNT];
+		Block * next;
+	};
+
+	static int const      TAG_SHIFT = 48;
+	static uint64_t const PTR_MASK  = ( uint64_t(1) << TAG_SHIFT ) - 1;
+
+	static Chunk * ptr_of( uint64_t tagged ) {
+		return (Chunk *)(uintptr_t)( tagged & PTR_MASK );
+	}
+
+	static uint64_t pack( Chunk * chunk, uint64_t prev ) {
+		return ( ( ( prev >> TAG_SHIFT ) + 1 ) << TAG_SHIFT ) | ( (uint64_t)(uintptr_t)chunk & PTR_MASK );
+	}
+
+	Chunk * pop() {
+		uint64_t top = m_root.load( std::memory_order_acquire );
+		for( ;; ) {
+			Chunk * chunk = ptr_of( top );
+			if ( chunk == BR_NULLPTR ) {
+				return BR_NULLPTR;
+			}
+			uint64_t next = pack( chunk->next, top );
+			if ( m_root.compare_exchange_weak( top, next, std::memory_order_acquire, std::memory_order_acquire ) ) {
+				return chunk;
+			}
+		}
+	}
+
+	/*
+	 *  将 first..last 这一段已经链好的节点整体压栈
+	 */
+	void push( Chunk * first, Chunk * last ) {
+		BR_ASSERT( ( (uint64_t)(uintptr_t)first & ~PTR_MASK ) == 0 );
+		uint64_t top = m_root.load( std::memory_order_relaxed );
+		for( ;; ) {
+			last->next = ptr_of( top );
+			if ( m_root.compare_exchange_weak( top, pack( first, top ), std::memory_order_release, std::memory_order_relaxed ) ) {
+				return;
+			}
+		}
+	}
+
+	/*
+	 *  分配新块，前 min( want, COUNT ) 项直接交给调用者，其余整段压栈；返回交出的项数
+	 */
+	int carve( void ** out, int want ) {
+		Block * block = (Block *)Policy::allocate( sizeof(Block) );
+		uint64_t first = (uint64_t)(uintptr_t)block;
+		if ( ( ( first | ( first + sizeof(Block) - 1 ) ) & ~PTR_MASK ) != 0 ) {
+			Policy::deallocate( block, sizeof(Block) );
+			throw std::runtime_error( "LockFreeMemPool: block address exceeds 48 bits" );
+		}
+		Block * head = m_blocks.load( std::memory_order_relaxed );
+		do {
+			block->next = head;
+		} while ( !m_blocks.compare_exchange_weak( head, block, std::memory_order_release, std::memory_order_relaxed ) );
+
+		int take = want < COUNT ? want : COUNT;
+		for( int i=0; i<take; ++i ) {
+			out[i] = &block->chunk[i];
+		}
+		if ( take < COUNT ) {
+			for( int i=take; i<COUNT-1; ++i ) {
+				block->chunk[i].next = &block->chunk[i+1];
+			}
+			push( &block->chunk[take], &block->chunk[COUNT-1] );
+		}
+		return take;
+	}
+
+	void count_alloc( int n ) {
+		m_curr_alloc.fetch_add( n, std::memory_order_relaxed );
+		m_have_alloc.fetch_add( n, std::memory_order_relaxed );
+		m_untracked.fetch_add( n, std::memory_order_relaxed );
+	}
+
+	std::atomic< uint64_t >  m_root;
+	std::atomic< Block * >   m_blocks;
+	std::atomic< int >       m_curr_alloc;
+	std::atomic< long long > m_have_alloc;
+	std::atomic< int >       m_untracked;
+};
+
+}
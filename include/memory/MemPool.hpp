@@ -5,23 +5,50 @@
 
 #include <config.hpp>
 
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <memory/BlockPolicy.hpp>
 #include <memory/MemPoolBase.hpp>
 #include <structure/DynArrPOD.hpp>
 
 namespace BR {
+namespace detail {
+/*
+ *  @brief Tp 在内存池中的项大小：sizeof(Tp) 按 max(alignof(Tp), 8) 向上取整
+ *
+ *  块来自 ::operator new 或页映射，只保证 max_align_t 的对齐
+ */
+template< class Tp >
+struct PoolItemSize {
+	static std::size_t const ALIGN = alignof(Tp) > 8 ? alignof(Tp) : 8;
+	static int const value = (int)( ( sizeof(Tp) + ALIGN - 1 ) / ALIGN * ALIGN );
+
+	static_assert( alignof(Tp) <= alignof(std::max_align_t), "over-aligned types are not supported" );
+};
+
+} // namespace detail
+
 /*
  *  @brief 内存池
+ *  @param  SIZE    每项字节数
+ *  @param  Policy  块策略，决定每块的项数以及块内存的来源，见 BlockPolicy.hpp
  */
-template< int SIZE >
+template< int SIZE, class Policy = DefaultBlockPolicy >
 class MemPool : public MemPoolBase {
 public:
 	MemPool() :
-		m_root( BR_NULLPTR ), m_curr_alloc(0), m_have_alloc(0), m_max_alloc(0), m_untracked(0) { }
+		m_blocks(), m_root( BR_NULLPTR ), m_curr_alloc(0), m_have_alloc(0), m_max_alloc(0), m_untracked(0),
+		m_trim_trigger( INT_MAX ), m_trim_keep( 0 ), m_trim_next( INT_MAX ), m_sampler() { }
 
 	~MemPool() {
 		// Delete the blocks.
 		for( int i=0; i<m_blocks.size(); ++i ) {
-			delete m_blocks[i];
+			Policy::deallocate( m_blocks[i], sizeof(Block) );
 		}
 	}
 
@@ -35,27 +62,38 @@ public:
 
 	virtual void * alloc() {
 		if ( m_root == BR_NULLPTR ) {
-			// 分配新块
-			Block * block = new Block();
-			m_blocks.push( block );
-
-			for( int i=0; i<COUNT-1; ++i ) {
-				block->chunk[i].next = &block->chunk[i+1];
-			}
-			block->chunk[COUNT-1].next = BR_NULLPTR;
-			m_root = block->chunk;
+			new_block( 0 );
 		}
 		void * result = m_root;
 		m_root = m_root->next;
-		++m_curr_alloc;
-		if ( m_curr_alloc > m_max_alloc ) {
-			m_max_alloc = m_curr_alloc;
+		count_alloc( 1 );
+		if ( m_sampler.tick() ) {
+			m_sampler.record( BR_RETURN_ADDRESS() );
 		}
-		++m_have_alloc;
-		++m_untracked;
 		return result;
 	}
 
+	virtual void alloc_n( void ** out, int n ) {
+		int i = 0;
+		// 先取空闲链表
+		while ( i < n && m_root != BR_NULLPTR ) {
+			out[i++] = m_root;
+			m_root = m_root->next;
+		}
+		// 链表取空后直接从新块整段切出，余下的部分挂入空闲链表
+		while ( i < n ) {
+			int take = n - i < COUNT ? n - i : COUNT;
+			Block * block = new_block( take );
+			for( int j=0; j<take; ++j ) {
+				out[i++] = &block->chunk[j];
+			}
+		}
+		count_alloc( n );
+		if ( m_sampler.tick( n ) ) {
+			m_sampler.record( BR_RETURN_ADDRESS() );
+		}
+	}
+
 	virtual void free( void * mem ) {
 		if ( !mem ) {
 			return;
@@ -67,11 +105,150 @@ public:
 #endif
 		chunk->next = m_root;
 		m_root = chunk;
+		check_trim();
+	}
+
+	virtual void free_n( void * const * in, int n ) {
+		// 先在本地串成一段，再整段接到空闲链表头
+		Chunk * head = m_root;
+		int freed = 0;
+		for( int i=0; i<n; ++i ) {
+			if ( !in[i] ) {
+				continue;
+			}
+			Chunk * chunk = (Chunk *)in[i];
+#ifndef NDEBUG
+			memset( chunk, 0xFE, sizeof(Chunk) );
+#endif
+			chunk->next = head;
+			head = chunk;
+			++freed;
+		}
+		m_root = head;
+		m_curr_alloc -= freed;
+		check_trim();
+	}
+
+	/*
+	 *  释放完全空闲的块，但至少保留 keep 个空闲项；返回释放的块数
+	 *
+	 *  只在调用时遍历一次空闲链表统计每块的空闲项数，alloc/free 不额外记账。
+	 */
+	int trim( int keep = 0 ) {
+		int nblocks = m_blocks.size();
+		int free_items = nblocks * COUNT - m_curr_alloc;
+		if ( free_items - COUNT < keep ) {
+			return 0;
+		}
+
+		std::vector< Block * > sorted( m_blocks.mem(), m_blocks.mem() + nblocks );
+		std::sort( sorted.begin(), sorted.end() );
+		std::vector< int > free_count( nblocks, 0 );
+		for( Chunk * chunk = m_root; chunk != BR_NULLPTR; chunk = chunk->next ) {
+			++free_count[ block_index( sorted, chunk ) ];
+		}
+
+		// 标记要释放的块（空闲计数置为 -1）
+		int released = 0;
+		for( int i=0; i<nblocks && free_items - COUNT >= keep; ++i ) {
+			if ( free_count[i] == COUNT ) {
+				free_count[i] = -1;
+				free_items -= COUNT;
+				++released;
+			}
+		}
+		if ( released == 0 ) {
+			return 0;
+		}
+
+		// 重建空闲链表，跳过落在被释放块中的项
+		Chunk * head = BR_NULLPTR;
+		Chunk * chunk = m_root;
+		while ( chunk != BR_NULLPTR ) {
+			Chunk * next = chunk->next;
+			if ( free_count[ block_index( sorted, chunk ) ] >= 0 ) {
+				chunk->next = head;
+				head = chunk;
+			}
+			chunk = next;
+		}
+		m_root = head;
+
+		for( int i=0; i<nblocks; ++i ) {
+			if ( free_count[i] < 0 ) {
+				Policy::deallocate( sorted[i], sizeof(Block) );
+				sorted[i] = BR_NULLPTR;
+			}
+		}
+		int live = 0;
+		for( int i=0; i<nblocks; ++i ) {
+			if ( sorted[i] != BR_NULLPTR ) {
+				m_blocks[live++] = sorted[i];
+			}
+		}
+		while ( m_blocks.size() > live ) {
+			m_blocks.pop_back();
+		}
+		return released;
+	}
+
+	int shrink_to_fit() {
+		return trim( 0 );
+	}
+
+	/*
+	 *  自动回收策略：空闲项超过 trigger 时回收到只剩 keep 个空闲项；
+	 *  trigger 应明显大于 keep，避免在阈值附近反复分配和释放块
+	 *
+	 *  空闲项分散在各块中时 trim 可能一块也放不掉，此后要等空闲项再增加
+	 *  max( trigger - keep, 剩余空闲项数 ) 才会再次尝试，使每次遍历空闲链表的开销
+	 *  摊到同样多次的释放上；空闲链表取空（分配新块）时恢复到 trigger。
+	 */
+	void set_auto_trim( int trigger, int keep ) {
+		BR_ASSERT( trigger > keep );
+		m_trim_trigger = trigger;
+		m_trim_keep = keep;
+		m_trim_next = trigger;
+	}
+
+	void disable_auto_trim() {
+		m_trim_trigger = INT_MAX;
+		m_trim_next = INT_MAX;
+	}
+
+	int blocks() const {
+		return m_blocks.size();
+	}
+
+	void trace( char const * name ) const {
+		printf( "Mempool %s watermark=%d [%dk] current=%d size=%d nAlloc=%lld blocks=%d\n",
+			name, m_max_alloc, m_max_alloc*SIZE/1024, m_curr_alloc, SIZE, m_have_alloc, m_blocks.size() );
+	}
+
+	virtual void stats( MemPoolStats & out ) const {
+		out = MemPoolStats();
+		out.item_size = SIZE;
+		out.items_per_block = COUNT;
+		out.curr_alloc = m_curr_alloc;
+		out.max_alloc = m_max_alloc;
+		out.have_alloc = m_have_alloc;
+		out.untracked = m_untracked;
+		out.blocks = m_blocks.size();
+		out.bytes_reserved = (long long)m_blocks.size() * sizeof(Block);
+		out.bytes_in_use = (long long)m_curr_alloc * SIZE;
+		out.sample_period = m_sampler.period();
+		m_sampler.collect( out.sites );
+	}
+
+	/*
+	 *  每 period 次分配采样一次调用位置，0 表示关闭
+	 */
+	void set_sample_period( int period ) {
+		m_sampler.set_period( period );
 	}
 
-	void trace( char const * name ) {
-		printf( "Mempool %s watermark=%d [%dk] current=%d size=%d nAlloc=%d blocks=%d\n",
-			name, m_max_alloc, m_max_alloc*SIZE/1024, m_curr_alloc, SIZE, m_have_alloc, m_block.size() );
+	void clear_samples() {
+		m_sampler.clear();
 	}
 
 	void track() {
@@ -82,9 +259,12 @@ public:
 		return m_untracked;
 	}
 
-	static int const COUNT = (4*1024) / SIZE;
+	static int const COUNT = Policy::template Count< SIZE >::value;
 
 private:
+	MemPool( MemPool const & );
+	MemPool & operator=( MemPool const & );
+
 	union Chunk {
 		Chunk * next;
 		char    mem[SIZE];
@@ -94,12 +274,59 @@ private:
 		Chunk chunk[COUNT];
 	};
 
+	/*
+	 *  分配新块，并把 first 及之后的项挂入空闲链表（调用时链表必须为空）
+	 */
+	Block * new_block( int first ) {
+		Block * block = (Block *)Policy::allocate( sizeof(Block) );
+		m_blocks.push_back( block );
+		m_trim_next = m_trim_trigger;
+
+		for( int i=first; i<COUNT-1; ++i ) {
+			block->chunk[i].next = &block->chunk[i+1];
+		}
+		if ( first < COUNT ) {
+			block->chunk[COUNT-1].next = BR_NULLPTR;
+			m_root = &block->chunk[first];
+		}
+		return block;
+	}
+
+	static int block_index( std::vector< Block * > const & sorted, Chunk const * chunk ) {
+		typename std::vector< Block * >::const_iterator it =
+			std::upper_bound( sorted.begin(), sorted.end(), (Block *)chunk );
+		return int( it - sorted.begin() ) - 1;
+	}
+
+	void check_trim() {
+		if ( m_blocks.size() * COUNT - m_curr_alloc <= m_trim_next ) {
+			return;
+		}
+		trim( m_trim_keep );
+		long long free_items = (long long)m_blocks.size() * COUNT - m_curr_alloc;
+		long long next = free_items + std::max< long long >( m_trim_trigger - m_trim_keep, free_items );
+		m_trim_next = (int)std::min< long long >( std::max< long long >( next, m_trim_trigger ), INT_MAX );
+	}
+
+	void count_alloc( int n ) {
+		m_curr_alloc += n;
+		if ( m_curr_alloc > m_max_alloc ) {
+			m_max_alloc = m_curr_alloc;
+		}
+		m_have_alloc += n;
+		m_untracked += n;
+	}
+
 	DynArrPOD< Block *, 10 > m_blocks;
 	Chunk * m_root;
 	int m_curr_alloc;
-	int m_have_alloc;
+	long long m_have_alloc;
 	int m_max_alloc;
 	int m_untracked;
+	int m_trim_trigger;
+	int m_trim_keep;
+	int m_trim_next;
+	AllocSampler m_sampler;
 };
 
 }
\ No newline at end of file
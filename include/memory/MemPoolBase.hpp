@@ -2,6 +2,8 @@
  * @file  memory/MemPoolBase.hpp
  */
 #pragma once
+
+#include <memory/MemPoolStats.hpp>
  
 namespace BR {
 /*
@@ -16,6 +18,38 @@ public:
     virtual void * alloc() = 0;
     virtual void free( void * ) = 0;
     virtual void track() = 0;
+
+    /*
+     *  批量分配/释放 n 项，默认逐项调用 alloc/free，子类可整段处理
+     */
+    virtual void alloc_n( void ** out, int n ) {
+        for( int i=0; i<n; ++i ) {
+            out[i] = alloc();
+        }
+    }
+
+    virtual void free_n( void * const * in, int n ) {
+        for( int i=0; i<n; ++i ) {
+            free( in[i] );
+        }
+    }
+
+    /*
+     *  填写统计快照，默认只给出项大小
+     */
+    virtual void stats( MemPoolStats & out ) const {
+        out = MemPoolStats();
+        out.item_size = item_size();
+    }
+
+    /*
+     *  取一次统计快照交给回调
+     */
+    void report( char const * name, MemPoolStatsCallback callback, void * user ) const {
+        MemPoolStats snapshot;
+        stats( snapshot );
+        callback( name, snapshot, user );
+    }
 };
 
 }
\ No newline at end of file
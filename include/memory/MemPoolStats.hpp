@@ -0,0 +1,154 @@
+﻿/*
+ * @file  include/memory/MemPoolStats.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <climits>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#if defined(__GNUC__)
+#	define BR_RETURN_ADDRESS() __builtin_return_address( 0 )
+#elif defined(_MSC_VER)
+#	include <intrin.h>
+#	define BR_RETURN_ADDRESS() _ReturnAddress()
+#else
+#	define BR_RETURN_ADDRESS() BR_NULLPTR
+#endif
+
+namespace BR {
+/*
+ *  @brief 单个线程在内存池上的计数
+ */
+struct MemPoolThreadStats {
+	int       slot;       // 线程槽位编号
+	int       cached;     // 弹匣中暂存的空闲项
+	long long allocs;
+	long long frees;
+	int       untracked;
+};
+
+/*
+ *  @brief 采样到的分配位置
+ */
+struct MemPoolSiteStats {
+	void const * site;    // 调用 alloc 的返回地址
+	long long    samples;
+};
+
+/*
+ *  @brief 内存池统计快照
+ */
+struct MemPoolStats {
+	MemPoolStats() :
+		item_size( 0 ), items_per_block( 0 ), curr_alloc( 0 ), max_alloc( 0 ), have_alloc( 0 ),
+		untracked( 0 ), blocks( 0 ), bytes_reserved( 0 ), bytes_in_use( 0 ), sample_period( 0 ),
+		threads(), sites() { }
+
+	int       item_size;
+	int       items_per_block;
+	int       curr_alloc;
+	int       max_alloc;
+	long long have_alloc;
+	int       untracked;
+	int       blocks;
+	long long bytes_reserved;
+	long long bytes_in_use;
+	int       sample_period;
+
+	std::vector< MemPoolThreadStats > threads;
+	std::vector< MemPoolSiteStats >   sites;
+};
+
+typedef void (*MemPoolStatsCallback)( char const * name, MemPoolStats const & stats, void * user );
+
+/*
+ *  @brief 以 JSON 对象输出统计快照
+ */
+template< class CharType, class CharTraits >
+std::basic_ostream< CharType, CharTraits > & write_json(
+	std::basic_ostream< CharType, CharTraits > & ostr,
+	MemPoolStats const & stats,
+	char const * name = BR_NULLPTR
+) {
+	ostr << '{';
+	if ( name != BR_NULLPTR ) {
+		ostr << "\"name\":\"" << name << "\",";
+	}
+	ostr << "\"item_size\":" << stats.item_size
+		<< ",\"items_per_block\":" << stats.items_per_block
+		<< ",\"curr_alloc\":" << stats.curr_alloc
+		<< ",\"max_alloc\":" << stats.max_alloc
+		<< ",\"have_alloc\":" << stats.have_alloc
+		<< ",\"untracked\":" << stats.untracked
+		<< ",\"blocks\":" << stats.blocks
+		<< ",\"bytes_reserved\":" << stats.bytes_reserved
+		<< ",\"bytes_in_use\":" << stats.bytes_in_use
+		<< ",\"sample_period\":" << stats.sample_period
+		<< ",\"threads\":[";
+	for( std::size_t i=0; i<stats.threads.size(); ++i ) {
+		MemPoolThreadStats const & t = stats.threads[i];
+		ostr << ( i ? "," : "" ) << "{\"slot\":" << t.slot << ",\"cached\":" << t.cached
+			<< ",\"allocs\":" << t.allocs << ",\"frees\":" << t.frees << ",\"untracked\":" << t.untracked << '}';
+	}
+	ostr << "],\"sites\":[";
+	for( std::size_t i=0; i<stats.sites.size(); ++i ) {
+		ostr << ( i ? "," : "" ) << "{\"site\":\"" << stats.sites[i].site << "\",\"samples\":" << stats.sites[i].samples << '}';
+	}
+	return ostr << "]}";
+}
+
+/*
+ *  @brief 分配位置采样器
+ *
+ *  每 period 次分配记录一次调用者的返回地址；period 为 0 时关闭。
+ *  关闭时 tick() 只是一次自减和比较。采样器本身不加锁，由所属内存池负责同步。
+ */
+class AllocSampler {
+public:
+	AllocSampler() : m_period( 0 ), m_countdown( INT_MAX ), m_sites() { }
+
+	void set_period( int period ) {
+		BR_ASSERT( period >= 0 );
+		m_period = period;
+		m_countdown = period ? period : INT_MAX;
+	}
+
+	int period() const {
+		return m_period;
+	}
+
+	bool tick( int n = 1 ) {
+		return ( m_countdown -= n ) <= 0;
+	}
+
+	void record( void const * site ) {
+		if ( m_period == 0 ) {
+			m_countdown = INT_MAX;
+			return;
+		}
+		m_countdown = m_period;
+		++m_sites[site];
+	}
+
+	void collect( std::vector< MemPoolSiteStats > & out ) const {
+		for( std::map< void const *, long long >::const_iterator it = m_sites.begin(); it != m_sites.end(); ++it ) {
+			MemPoolSiteStats site = { it->first, it->second };
+			out.push_back( site );
+		}
+	}
+
+	void clear() {
+		m_sites.clear();
+	}
+
+private:
+	int                                 m_period;
+	int                                 m_countdown;
+	std::map< void const *, long long > m_sites;
+};
+
+}
@@ -0,0 +1,133 @@
+﻿/*
+ * @file  include/memory/ObjectPool.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <memory/MemPool.hpp>
+#include <structure/DynArrPOD.hpp>
+
+namespace BR {
+/*
+ *  @brief 管理构造与析构的类型化对象池
+ *  @param  Tp      对象类型
+ *  @param  Policy  底层 MemPool 的块策略
+ *
+ *  create/destroy 在池内存上构造与析构对象；acquire/release 是“回收不析构”模式：
+ *  release 只把仍处于构造状态的对象放入回收栈，acquire 优先取回这些对象，
+ *  适用于可以廉价重置、不必反复构造析构的对象，重置由调用者负责。
+ *  池析构时会析构回收栈中的对象，但不会析构仍在使用的对象。非线程安全。
+ */
+template< class Tp, class Policy = DefaultBlockPolicy >
+class ObjectPool {
+public:
+	typedef Tp value_type;
+
+	/*
+	 *  @brief 把对象交还给所属对象池的 unique_ptr 删除器
+	 */
+	class Deleter {
+	public:
+		Deleter() : m_pool( BR_NULLPTR ) { }
+		explicit Deleter( ObjectPool * pool ) : m_pool( pool ) { }
+
+		void operator()( Tp * obj ) const {
+			m_pool->destroy( obj );
+		}
+
+	private:
+		ObjectPool * m_pool;
+	};
+
+	typedef std::unique_ptr< Tp, Deleter > UniquePtr;
+
+	ObjectPool() : m_pool(), m_recycled() { }
+
+	~ObjectPool() {
+		while ( !m_recycled.empty() ) {
+			Tp * obj = m_recycled.pop_back();
+			obj->~Tp();
+		}
+	}
+
+	template< class... Args >
+	Tp * create( Args &&... args ) {
+		void * mem = m_pool.alloc();
+		try {
+			return new( mem ) Tp( std::forward< Args >( args )... );
+		} catch( ... ) {
+			m_pool.free( mem );
+			throw;
+		}
+	}
+
+	void destroy( Tp * obj ) {
+		if ( obj == BR_NULLPTR ) {
+			return;
+		}
+		obj->~Tp();
+		m_pool.free( obj );
+	}
+
+	template< class... Args >
+	UniquePtr create_unique( Args &&... args ) {
+		return UniquePtr( create( std::forward< Args >( args )... ), Deleter( this ) );
+	}
+
+	/*
+	 *  取回一个已回收的对象（不调用构造函数，args 被忽略），没有时才构造新对象
+	 */
+	template< class... Args >
+	Tp * acquire( Args &&... args ) {
+		if ( !m_recycled.empty() ) {
+			return m_recycled.pop_back();
+		}
+		return create( std::forward< Args >( args )... );
+	}
+
+	/*
+	 *  回收对象而不析构
+	 */
+	void release( Tp * obj ) {
+		if ( obj == BR_NULLPTR ) {
+			return;
+		}
+		m_recycled.push_back( obj );
+	}
+
+	/*
+	 *  析构回收栈中的全部对象并把内存还给池
+	 */
+	void purge() {
+		while ( !m_recycled.empty() ) {
+			destroy( m_recycled.pop_back() );
+		}
+	}
+
+	/*
+	 *  仍在使用的对象数（不含回收栈中的对象）
+	 */
+	int size() const {
+		return m_pool.curr_alloc() - m_recycled.size();
+	}
+
+	int recycled() const {
+		return m_recycled.size();
+	}
+
+	static int const ITEM_SIZE = detail::PoolItemSize< Tp >::value;
+
+private:
+	ObjectPool( ObjectPool const & );
+	ObjectPool & operator=( ObjectPool const & );
+
+	MemPool< ITEM_SIZE, Policy > m_pool;
+	DynArrPOD< Tp *, 16 >        m_recycled;
+};
+
+}
@@ -0,0 +1,118 @@
+﻿/*
+ * @file  include/memory/PoolAllocator.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <cstddef>
+#include <new>
+
+#include <memory/MemPool.hpp>
+#include <memory/ThreadCachedMemPool.hpp>
+
+namespace BR {
+/*
+ *  @brief PoolAllocator 的内存池选择器：单线程使用的 MemPool
+ */
+struct SingleThreadPoolSelector {
+	template< int SIZE >
+	struct apply {
+		typedef MemPool< SIZE > type;
+	};
+};
+
+/*
+ *  @brief PoolAllocator 的内存池选择器：可跨线程使用的 ThreadCachedMemPool
+ */
+struct ThreadCachedPoolSelector {
+	template< int SIZE >
+	struct apply {
+		typedef ThreadCachedMemPool< SIZE > type;
+	};
+};
+
+namespace detail {
+/*
+ *  @brief 按项大小共享的内存池，取整后尺寸相同的类型共用同一个池
+ *
+ *  与 PoolAllocator 分开，使 PoolAllocator< Tp > 可以在 Tp 尚不完整时实例化
+ */
+template< int ITEM_SIZE, class Selector >
+struct PoolAllocatorPool {
+	typedef typename Selector::template apply< ITEM_SIZE >::type PoolType;
+
+	static PoolType & get() {
+		static PoolType * instance = new PoolType();
+		return *instance;
+	}
+};
+
+} // namespace detail
+
+/*
+ *  @brief 满足 C++11 Allocator 要求的内存池分配器
+ *  @param  Tp        元素类型
+ *  @param  Selector  内存池选择器
+ *
+ *  单个对象的分配来自按 sizeof(Tp) 向上对齐后共享的内存池，因此节点式容器
+ *  （std::list、std::map、std::unordered_map 的节点）经 rebind 后每个节点都从池中分配；
+ *  一次分配多个对象（如 unordered_map 的桶数组）交给 ::operator new。
+ *  取整后尺寸相同的所有 PoolAllocator（不论 Tp）共享一个内存池，池本身永不析构，
+ *  以免静态容器在池之后析构。默认选择器非线程安全。
+ */
+template< class Tp, class Selector = SingleThreadPoolSelector >
+class PoolAllocator {
+public:
+	typedef Tp                value_type;
+	typedef Tp *              pointer;
+	typedef Tp const *        const_pointer;
+	typedef Tp &              reference;
+	typedef Tp const &        const_reference;
+	typedef std::size_t       size_type;
+	typedef std::ptrdiff_t    difference_type;
+
+	template< class Up >
+	struct rebind {
+		typedef PoolAllocator< Up, Selector > other;
+	};
+
+	PoolAllocator() { }
+
+	template< class Up >
+	PoolAllocator( PoolAllocator< Up, Selector > const & ) { }
+
+	Tp * allocate( std::size_t n ) {
+		if ( n == 1 ) {
+			return (Tp *)pool().alloc();
+		}
+		return (Tp *)::operator new( n * sizeof(Tp) );
+	}
+
+	void deallocate( Tp * mem, std::size_t n ) {
+		if ( n == 1 ) {
+			pool().free( mem );
+			return;
+		}
+		::operator delete( mem );
+	}
+
+private:
+	// 在成员函数内才计算项大小，类本身不要求 Tp 完整
+	template< class Up = Tp >
+	static typename detail::PoolAllocatorPool< detail::PoolItemSize< Up >::value, Selector >::PoolType & pool() {
+		return detail::PoolAllocatorPool< detail::PoolItemSize< Up >::value, Selector >::get();
+	}
+};
+
+template< class Tp, class Up, class Selector >
+inline bool operator==( PoolAllocator< Tp, Selector > const &, PoolAllocator< Up, Selector > const & ) {
+	return true;
+}
+
+template< class Tp, class Up, class Selector >
+inline bool operator!=( PoolAllocator< Tp, Selector > const &, PoolAllocator< Up, Selector > const & ) {
+	return false;
+}
+
+}
@@ -0,0 +1,158 @@
+﻿/*
+ * @file  include/memory/RawAlloc.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#	include <malloc.h>
+#endif // _WIN32
+
+#ifdef BR_HAS_MMAP
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif // BR_HAS_MMAP
+
+namespace BR {
+/*
+ *  @brief 按字节分配未初始化内存的分配器，DynArrPOD 等容器的默认分配器
+ *
+ *  分配器需提供 allocate( bytes )、deallocate( mem, bytes ) 与
+ *  reallocate( mem, old_bytes, new_bytes, used_bytes )，后者只需保留前 used_bytes 字节；
+ *  分配器可以带状态，容器会按值持有一份。
+ *  本分配器基于 malloc/realloc，扩容时由 C 库决定原地扩展还是搬移
+ *  （glibc 对大块内存内部使用 mremap）。
+ */
+struct HeapRawAlloc {
+	void * allocate( std::size_t bytes ) {
+		void * mem = std::malloc( bytes );
+		if ( mem == BR_NULLPTR ) {
+			throw std::bad_alloc();
+		}
+		return mem;
+	}
+
+	void deallocate( void * mem, std::size_t ) {
+		std::free( mem );
+	}
+
+	void * reallocate( void * mem, std::size_t, std::size_t new_bytes, std::size_t ) {
+		void * new_mem = std::realloc( mem, new_bytes );
+		if ( new_mem == BR_NULLPTR ) {
+			throw std::bad_alloc();
+		}
+		return new_mem;
+	}
+};
+
+/*
+ *  @brief 大缓冲区直接映射页面的分配器
+ *  @param  THRESHOLD  不小于该字节数的缓冲区用 mmap 分配
+ *
+ *  小缓冲区同 HeapRawAlloc；大缓冲区按页映射，在 Linux 上扩容时用 mremap 重新映射页表，
+ *  不复制数据，也不会在扩容期间同时占用新旧两份内存。
+ *  缓冲区属于哪一类完全由字节数决定，因此 deallocate/reallocate 必须给出准确的 old_bytes。
+ */
+template< std::size_t THRESHOLD = 1024*1024 >
+struct PageRawAlloc {
+	void * allocate( std::size_t bytes ) {
+#ifdef BR_HAS_MMAP
+		if ( bytes >= THRESHOLD ) {
+			void * mem = mmap( BR_NULLPTR, page_round( bytes ), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+			if ( mem == MAP_FAILED ) {
+				throw std::bad_alloc();
+			}
+			return mem;
+		}
+#endif // BR_HAS_MMAP
+		return HeapRawAlloc().allocate( bytes );
+	}
+
+	void deallocate( void * mem, std::size_t bytes ) {
+#ifdef BR_HAS_MMAP
+		if ( bytes >= THRESHOLD ) {
+			munmap( mem, page_round( bytes ) );
+			return;
+		}
+#endif // BR_HAS_MMAP
+		HeapRawAlloc().deallocate( mem, bytes );
+	}
+
+	void * reallocate( void * mem, std::size_t old_bytes, std::size_t new_bytes, std::size_t used_bytes ) {
+#ifdef BR_HAS_MREMAP
+		if ( old_bytes >= THRESHOLD && new_bytes >= THRESHOLD ) {
+			void * new_mem = mremap( mem, page_round( old_bytes ), page_round( new_bytes ), MREMAP_MAYMOVE );
+			if ( new_mem == MAP_FAILED ) {
+				throw std::bad_alloc();
+			}
+			return new_mem;
+		}
+#endif // BR_HAS_MREMAP
+		if ( old_bytes < THRESHOLD && new_bytes < THRESHOLD ) {
+			return HeapRawAlloc().reallocate( mem, old_bytes, new_bytes, used_bytes );
+		}
+		void * new_mem = allocate( new_bytes );
+		memcpy( new_mem, mem, used_bytes < new_bytes ? used_bytes : new_bytes );
+		deallocate( mem, old_bytes );
+		return new_mem;
+	}
+
+private:
+	static std::size_t page_round( std::size_t bytes ) {
+#ifdef BR_HAS_MMAP
+		static std::size_t const page = (std::size_t)sysconf( _SC_PAGESIZE );
+#else
+		std::size_t const page = 4096;
+#endif // BR_HAS_MMAP
+		return ( bytes + page - 1 ) & ~( page - 1 );
+	}
+};
+
+/*
+ *  @brief 按 ALIGN 字节对齐的分配器，供 SIMD 批量算法使用对齐的缓冲区
+ *  @param  ALIGN  对齐字节数，须为 2 的幂且不小于 sizeof(void*)
+ *
+ *  对齐内存没有对应的 realloc，扩容时分配新缓冲区并只复制前 used_bytes 字节。
+ */
+template< std::size_t ALIGN = 32 >
+struct AlignedRawAlloc {
+	static_assert( ( ALIGN & ( ALIGN - 1 ) ) == 0 && ALIGN >= sizeof(void *), "ALIGN must be a power of 2 and at least sizeof(void*)" );
+
+	void * allocate( std::size_t bytes ) {
+#ifdef _WIN32
+		void * mem = _aligned_malloc( bytes, ALIGN );
+		if ( mem == BR_NULLPTR ) {
+			throw std::bad_alloc();
+		}
+#else
+		void * mem = BR_NULLPTR;
+		if ( posix_memalign( &mem, ALIGN, bytes ) != 0 ) {
+			throw std::bad_alloc();
+		}
+#endif // _WIN32
+		return mem;
+	}
+
+	void deallocate( void * mem, std::size_t ) {
+#ifdef _WIN32
+		_aligned_free( mem );
+#else
+		std::free( mem );
+#endif // _WIN32
+	}
+
+	void * reallocate( void * mem, std::size_t, std::size_t new_bytes, std::size_t used_bytes ) {
+		void * new_mem = allocate( new_bytes );
+		memcpy( new_mem, mem, used_bytes < new_bytes ? used_bytes : new_bytes );
+		deallocate( mem, 0 );
+		return new_mem;
+	}
+};
+
+}
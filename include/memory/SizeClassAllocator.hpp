@@ -0,0 +1,132 @@
+﻿/*
+ * @file  include/memory/SizeClassAllocator.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <cstddef>
+#include <new>
+
+#include <memory/MemPool.hpp>
+
+namespace BR {
+/*
+ *  @brief 尺寸级别表，必须按升序给出且均为 8 的倍数
+ */
+template< int... SIZES >
+struct SizeClassList;
+
+template<>
+struct SizeClassList<> {
+	static int const COUNT = 0;
+	static int const MAX = 0;
+};
+
+template< int FIRST, int... REST >
+struct SizeClassList< FIRST, REST... > {
+	static_assert( FIRST % 8 == 0, "size class must be a multiple of 8" );
+	static_assert( SizeClassList< REST... >::COUNT == 0 || FIRST < SizeClassList< REST... >::MAX,
+		"size classes must be ascending" );
+
+	static int const COUNT = 1 + SizeClassList< REST... >::COUNT;
+	static int const MAX = SizeClassList< REST... >::COUNT == 0 ? FIRST : SizeClassList< REST... >::MAX;
+};
+
+typedef SizeClassList< 8, 16, 24, 32, 48, 64, 80, 96, 128, 160, 192, 256 > DefaultSizeClasses;
+
+namespace detail {
+/*
+ *  @brief 按尺寸级别表递归地持有一组 MemPool<N>
+ */
+template< class Policy, class List >
+struct SizeClassPools;
+
+template< class Policy >
+struct SizeClassPools< Policy, SizeClassList<> > {
+	void collect( MemPoolBase ** ) { }
+};
+
+template< class Policy, int FIRST, int... REST >
+struct SizeClassPools< Policy, SizeClassList< FIRST, REST... > > {
+	SizeClassPools() : pool(), rest() { }
+
+	void collect( MemPoolBase ** out ) {
+		*out = &pool;
+		rest.collect( out + 1 );
+	}
+
+	MemPool< FIRST, Policy >                               pool;
+	SizeClassPools< Policy, SizeClassList< REST... > >     rest;
+};
+
+} // namespace detail
+
+/*
+ *  @brief 由一组 MemPool 组成的小对象分配器
+ *  @param  Classes  尺寸级别表
+ *  @param  Policy   各内存池共用的块策略
+ *
+ *  请求的字节数先按 8 字节向上取整，再查表得到级别，查表本身没有分支；
+ *  超过最大级别的请求交给 ::operator new。
+ *  与 std::allocator 一样，释放时必须给出分配时的字节数。非线程安全。
+ */
+template< class Classes = DefaultSizeClasses, class Policy = DefaultBlockPolicy >
+class SizeClassAllocator {
+public:
+	SizeClassAllocator() : m_pools() {
+		m_pools.collect( m_class_pool );
+		int cls = 0;
+		for( int i=0; i<=SLOTS; ++i ) {
+			while ( m_class_pool[cls]->item_size() < i * 8 ) {
+				++cls;
+			}
+			m_slot_pool[i] = m_class_pool[cls];
+		}
+	}
+
+	void * allocate( std::size_t bytes ) {
+		if ( bytes > MAX_SIZE ) {
+			return ::operator new( bytes );
+		}
+		return pool_for( bytes )->alloc();
+	}
+
+	void deallocate( void * mem, std::size_t bytes ) {
+		if ( bytes > MAX_SIZE ) {
+			::operator delete( mem );
+			return;
+		}
+		pool_for( bytes )->free( mem );
+	}
+
+	/*
+	 *  bytes 实际占用的字节数
+	 */
+	std::size_t size_class( std::size_t bytes ) const {
+		return bytes > MAX_SIZE ? bytes : (std::size_t)pool_for( bytes )->item_size();
+	}
+
+	MemPoolBase * pool( int cls ) {
+		BR_ASSERT( cls >= 0 && cls < Classes::COUNT );
+		return m_class_pool[cls];
+	}
+
+	static std::size_t const MAX_SIZE = Classes::MAX;
+
+private:
+	SizeClassAllocator( SizeClassAllocator const & );
+	SizeClassAllocator & operator=( SizeClassAllocator const & );
+
+	static int const SLOTS = Classes::MAX / 8;
+
+	MemPoolBase * pool_for( std::size_t bytes ) const {
+		return m_slot_pool[ ( bytes + 7 ) >> 3 ];
+	}
+
+	detail::SizeClassPools< Policy, Classes > m_pools;
+	MemPoolBase * m_class_pool[Classes::COUNT];
+	MemPoolBase * m_slot_pool[SLOTS + 1];
+};
+
+}
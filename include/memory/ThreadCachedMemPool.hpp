@@ -0,0 +1,356 @@
+﻿/*
+ * @file  include/memory/ThreadCachedMemPool.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <memory/MemPoolBase.hpp>
+#include <memory/MemPool.hpp>
+
+namespace BR {
+namespace detail {
+/*
+ *  @brief 线程槽位编号
+ *
+ *  为每个线程分配一个从 0 开始的小整数编号，线程退出时归还，
+ *  供新线程复用，因此编号总是稠密的。
+ */
+class ThreadSlot {
+public:
+	static int id() {
+		static thread_local Holder holder;
+		return holder.id;
+	}
+
+private:
+	struct Registry {
+		Registry() : mutex(), free_ids(), next(0) { }
+
+		std::mutex         mutex;
+		std::vector< int > free_ids;
+		int                next;
+	};
+
+	struct Holder {
+		Holder() : id( acquire() ) { }
+		~Holder() { release( id ); }
+
+		int id;
+	};
+
+	static Registry & registry() {
+		static Registry reg;
+		return reg;
+	}
+
+	static int acquire() {
+		Registry & reg = registry();
+		std::lock_guard< std::mutex > lock( reg.mutex );
+		if ( reg.free_ids.empty() ) {
+			return reg.next++;
+		}
+		int id = reg.free_ids.back();
+		reg.free_ids.pop_back();
+		return id;
+	}
+
+	static void release( int id ) {
+		Registry & reg = registry();
+		std::lock_guard< std::mutex > lock( reg.mutex );
+		reg.free_ids.push_back( id );
+	}
+};
+
+} // namespace detail
+
+/*
+ *  @brief 带线程本地缓存的并发内存池
+ *
+ *  每个线程拥有一个容量为 2*MAGAZINE 的本地弹匣，alloc/free 只访问本线程的弹匣；
+ *  弹匣空时从共享仓库（加锁的 MemPool<SIZE, Policy>）一次取 MAGAZINE 个，
+ *  满时一次归还 MAGAZINE 个。线程槽位编号不小于 MAX_THREADS 的线程直接走加锁的仓库。
+ *  线程退出后其弹匣中的内存留在池中，由复用该槽位的线程继续使用。
+ */
+template< int SIZE, int MAGAZINE = 32, int MAX_THREADS = 64, class Policy = DefaultBlockPolicy >
+class ThreadCachedMemPool : public MemPoolBase {
+public:
+	ThreadCachedMemPool() : m_mutex(), m_depot(), m_sampler(), m_sample_period( 0 ), m_refilled( 0 ) {
+		for( int i=0; i<MAX_THREADS; ++i ) {
+			m_caches[i].store( BR_NULLPTR, std::memory_order_relaxed );
+		}
+	}
+
+	~ThreadCachedMemPool() {
+		// 块由 m_depot 统一释放，这里只删除弹匣
+		for( int i=0; i<MAX_THREADS; ++i ) {
+			delete m_caches[i].load( std::memory_order_relaxed );
+		}
+	}
+
+	virtual int item_size() const {
+		return SIZE;
+	}
+
+	virtual void * alloc() {
+		Cache * cache = local_cache();
+		if ( cache == BR_NULLPTR ) {
+			std::lock_guard< std::mutex > lock( m_mutex );
+			return m_depot.alloc();
+		}
+		int count = cache->count.load( std::memory_order_relaxed );
+		if ( count == 0 ) {
+			count = refill( cache );
+		}
+		--count;
+		cache->count.store( count, std::memory_order_relaxed );
+		bump( cache->untracked, 1 );
+		bump( cache->allocs, 1LL );
+		if ( m_sample_period.load( std::memory_order_relaxed ) != 0 && --cache->sample_countdown <= 0 ) {
+			sample( cache, BR_RETURN_ADDRESS() );
+		}
+		return cache->items[count];
+	}
+
+	virtual void free( void * mem ) {
+		if ( !mem ) {
+			return;
+		}
+		Cache * cache = local_cache();
+		if ( cache == BR_NULLPTR ) {
+			std::lock_guard< std::mutex > lock( m_mutex );
+			m_depot.free( mem );
+			return;
+		}
+		int count = cache->count.load( std::memory_order_relaxed );
+		if ( count == CAPACITY ) {
+			count = drain( cache );
+		}
+		cache->items[count] = mem;
+		cache->count.store( count+1, std::memory_order_relaxed );
+		bump( cache->frees, 1LL );
+	}
+
+	virtual void alloc_n( void ** out, int n ) {
+		Cache * cache = local_cache();
+		if ( cache == BR_NULLPTR ) {
+			std::lock_guard< std::mutex > lock( m_mutex );
+			m_depot.alloc_n( out, n );
+			return;
+		}
+		// 先取弹匣中的项，不足部分一次性从仓库取
+		int count = cache->count.load( std::memory_order_relaxed );
+		int take = n < count ? n : count;
+		for( int i=0; i<take; ++i ) {
+			out[i] = cache->items[--count];
+		}
+		cache->count.store( count, std::memory_order_relaxed );
+		bump( cache->untracked, take );
+		bump( cache->allocs, (long long)n );
+		if ( take < n ) {
+			std::lock_guard< std::mutex > lock( m_mutex );
+			m_depot.alloc_n( out + take, n - take );
+			m_refilled += n - take;
+		}
+	}
+
+	virtual void free_n( void * const * in, int n ) {
+		Cache * cache = local_cache();
+		if ( cache == BR_NULLPTR ) {
+			std::lock_guard< std::mutex > lock( m_mutex );
+			m_depot.free_n( in, n );
+			return;
+		}
+		// 先填满弹匣，溢出部分一次性还给仓库；空指针不计入释放次数
+		int count = cache->count.load( std::memory_order_relaxed );
+		int i = 0;
+		long long freed = 0;
+		for( ; i<n && count<CAPACITY; ++i ) {
+			if ( in[i] ) {
+				cache->items[count++] = in[i];
+				++freed;
+			}
+		}
+		for( int j=i; j<n; ++j ) {
+			freed += in[j] != BR_NULLPTR;
+		}
+		cache->count.store( count, std::memory_order_relaxed );
+		bump( cache->frees, freed );
+		if ( i < n ) {
+			std::lock_guard< std::mutex > lock( m_mutex );
+			m_depot.free_n( in + i, n - i );
+		}
+	}
+
+	virtual void track() {
+		Cache * cache = local_cache();
+		if ( cache == BR_NULLPTR ) {
+			std::lock_guard< std::mutex > lock( m_mutex );
+			m_depot.track();
+			return;
+		}
+		bump( cache->untracked, -1 );
+	}
+
+	/*
+	 *  将本线程弹匣中的全部内存归还仓库
+	 */
+	void flush() {
+		Cache * cache = local_cache();
+		if ( cache == BR_NULLPTR ) {
+			return;
+		}
+		int count = cache->count.load( std::memory_order_relaxed );
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_depot.free_n( cache->items, count );
+		cache->count.store( 0, std::memory_order_relaxed );
+	}
+
+	/*
+	 *  回收仓库中完全空闲的块；仍有项留在某个线程弹匣中的块不会被回收，
+	 *  需要时先在各线程调用 flush()
+	 */
+	int trim( int keep = 0 ) {
+		std::lock_guard< std::mutex > lock( m_mutex );
+		return m_depot.trim( keep );
+	}
+
+	/*
+	 *  统计值在其他线程并发分配时只是近似值
+	 */
+	int curr_alloc() const {
+		std::lock_guard< std::mutex > lock( m_mutex );
+		int result = m_depot.curr_alloc();
+		for( int i=0; i<MAX_THREADS; ++i ) {
+			Cache const * cache = m_caches[i].load( std::memory_order_acquire );
+			if ( cache != BR_NULLPTR ) {
+				result -= cache->count.load( std::memory_order_relaxed );
+			}
+		}
+		return result;
+	}
+
+	int untracked() const {
+		std::lock_guard< std::mutex > lock( m_mutex );
+		int result = m_depot.untracked();
+		for( int i=0; i<MAX_THREADS; ++i ) {
+			Cache const * cache = m_caches[i].load( std::memory_order_acquire );
+			if ( cache != BR_NULLPTR ) {
+				result += cache->untracked.load( std::memory_order_relaxed );
+			}
+		}
+		return result;
+	}
+
+	virtual void stats( MemPoolStats & out ) const {
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_depot.stats( out );
+		out.sample_period = m_sample_period.load( std::memory_order_relaxed );
+		m_sampler.collect( out.sites );
+		for( int i=0; i<MAX_THREADS; ++i ) {
+			Cache const * cache = m_caches[i].load( std::memory_order_acquire );
+			if ( cache == BR_NULLPTR ) {
+				continue;
+			}
+			MemPoolThreadStats thread = {
+				i,
+				cache->count.load( std::memory_order_relaxed ),
+				cache->allocs.load( std::memory_order_relaxed ),
+				cache->frees.load( std::memory_order_relaxed ),
+				cache->untracked.load( std::memory_order_relaxed )
+			};
+			out.threads.push_back( thread );
+			out.curr_alloc -= thread.cached;
+			out.have_alloc += thread.allocs;
+			out.untracked += thread.untracked;
+		}
+		// 仓库的分配计数包含了向弹匣的补充，扣除后只剩无槽位线程的直接分配
+		out.have_alloc -= m_refilled;
+		out.bytes_in_use = (long long)out.curr_alloc * SIZE;
+	}
+
+	/*
+	 *  每个线程每 period 次分配采样一次调用位置，0 表示关闭
+	 */
+	void set_sample_period( int period ) {
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_sampler.set_period( period );
+		m_sample_period.store( period, std::memory_order_relaxed );
+	}
+
+	static int const CAPACITY = 2 * MAGAZINE;
+
+private:
+	/*
+	 *  单个线程的弹匣，只由拥有它的线程修改；
+	 *  计数使用原子变量仅为了让统计接口可以在其他线程读取
+	 */
+	struct Cache {
+		Cache() : count( 0 ), untracked( 0 ), allocs( 0 ), frees( 0 ), sample_countdown( 0 ) { }
+
+		char                     pad_front[BR_CACHE_LINE_SIZE];
+		std::atomic< int >       count;
+		std::atomic< int >       untracked;
+		std::atomic< long long > allocs;
+		std::atomic< long long > frees;
+		int                      sample_countdown;
+		void *                   items[CAPACITY];
+		char                     pad_back[BR_CACHE_LINE_SIZE];
+	};
+
+	template< class Tp >
+	static void bump( std::atomic< Tp > & counter, Tp delta ) {
+		counter.store( counter.load( std::memory_order_relaxed ) + delta, std::memory_order_relaxed );
+	}
+
+	Cache * local_cache() {
+		int id = detail::ThreadSlot::id();
+		if ( id >= MAX_THREADS ) {
+			return BR_NULLPTR;
+		}
+		Cache * cache = m_caches[id].load( std::memory_order_relaxed );
+		if ( cache == BR_NULLPTR ) {
+			cache = new Cache();
+			m_caches[id].store( cache, std::memory_order_release );
+		}
+		return cache;
+	}
+
+	void sample( Cache * cache, void const * site ) {
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_sampler.record( site );
+		cache->sample_countdown = m_sample_period.load( std::memory_order_relaxed );
+	}
+
+	int refill( Cache * cache ) {
+		std::lock_guard< std::mutex > lock( m_mutex );
+		m_depot.alloc_n( cache->items, MAGAZINE );
+		m_refilled += MAGAZINE;
+		// 仓库把取入弹匣的每一项都记为未跟踪，这里先行扣除
+		bump( cache->untracked, -MAGAZINE );
+		return MAGAZINE;
+	}
+
+	int drain( Cache * cache ) {
+		{
+			std::lock_guard< std::mutex > lock( m_mutex );
+			m_depot.free_n( cache->items, MAGAZINE );
+		}
+		// 保留最近释放的一半，它们更可能仍在缓存中
+		memmove( cache->items, cache->items + MAGAZINE, sizeof(void *) * MAGAZINE );
+		return CAPACITY - MAGAZINE;
+	}
+
+	mutable std::mutex      m_mutex;
+	MemPool< SIZE, Policy > m_depot;
+	AllocSampler            m_sampler;
+	std::atomic< int >      m_sample_period;
+	long long               m_refilled;     // 由 m_mutex 保护
+	std::atomic< Cache * >  m_caches[MAX_THREADS];
+};
+
+}
@@ -0,0 +1,52 @@
+/*
+ * @file  include/simd/CpuFeatures.hpp
+ * @brief 运行时 CPU 特性检测与按指令集编译的函数属性
+ */
+#pragma once
+
+#include <config.hpp>
+
+/*
+ *  BR_HAS_X86_SIMD  可以使用 SSE2 内建函数，并能为单个函数开启更高的指令集
+ *  BR_TARGET_AVX2   修饰使用 AVX2 内建函数的函数，不需要全局 -mavx2
+ */
+#if ( defined(__GNUC__) || defined(__clang__) ) && ( defined(__x86_64__) || ( defined(__i386__) && defined(__SSE2__) ) )
+#	define BR_HAS_X86_SIMD
+#	include <immintrin.h>
+#	define BR_TARGET_AVX2      __attribute__(( target( "avx2" ) ))
+#	define BR_TARGET_AVX2_FMA  __attribute__(( target( "avx2,fma" ) ))
+#	define BR_TARGET_BMI2      __attribute__(( target( "bmi2" ) ))
+#endif
+
+namespace BR {
+namespace simd {
+
+inline bool has_avx2() {
+#ifdef BR_HAS_X86_SIMD
+	static bool const result = __builtin_cpu_supports( "avx2" ) != 0;
+	return result;
+#else
+	return false;
+#endif // BR_HAS_X86_SIMD
+}
+
+inline bool has_fma() {
+#ifdef BR_HAS_X86_SIMD
+	static bool const result = __builtin_cpu_supports( "fma" ) != 0;
+	return result;
+#else
+	return false;
+#endif // BR_HAS_X86_SIMD
+}
+
+inline bool has_bmi2() {
+#ifdef BR_HAS_X86_SIMD
+	static bool const result = __builtin_cpu_supports( "bmi2" ) != 0;
+	return result;
+#else
+	return false;
+#endif // BR_HAS_X86_SIMD
+}
+
+} // namespace simd
+}
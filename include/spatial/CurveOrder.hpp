@@ -0,0 +1,286 @@
+/*
+ * @file  include/spatial/CurveOrder.hpp
+ * @brief 空间填充曲线（Morton、Hilbert）键与并行基数排序，用于按空间局部性重排点集
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include HEADER_STDINT
+
+#include <concurrent/Parallel.hpp>
+#include <simd/CpuFeatures.hpp>
+
+namespace BR {
+
+enum CurveType {
+	CURVE_MORTON,
+	CURVE_HILBERT
+};
+
+namespace detail {
+
+/*
+ *  把低 16 位分散到偶数位上
+ */
+inline std::uint32_t morton_spread( std::uint32_t v ) {
+	v &= 0xFFFF;
+	v = ( v | ( v << 8 ) ) & 0x00FF00FF;
+	v = ( v | ( v << 4 ) ) & 0x0F0F0F0F;
+	v = ( v | ( v << 2 ) ) & 0x33333333;
+	v = ( v | ( v << 1 ) ) & 0x55555555;
+	return v;
+}
+
+} // namespace detail
+
+/*
+ *  把两个 16 位坐标交错成 32 位 Morton（Z 序）键，x 占偶数位
+ */
+inline std::uint32_t morton_key( std::uint32_t x, std::uint32_t y ) {
+	return detail::morton_spread( x ) | ( detail::morton_spread( y ) << 1 );
+}
+
+/*
+ *  两个 16 位坐标在 2^16 x 2^16 网格上的 Hilbert 曲线序号；曲线上相邻的两格在网格上也相邻
+ *
+ *  查表实现：每步取 x、y 各 2 位，由当前朝向（4 种）查出 4 位序号与下一步的朝向，8 步完成。
+ */
+inline std::uint32_t hilbert_key( std::uint32_t x, std::uint32_t y ) {
+	// 下标为 朝向*16 + (x 的 2 位) + (y 的 2 位)*4，值为 下一朝向<<4 | 4 位序号
+	static unsigned char const TABLE[64] = {
+		0x00, 0x11, 0x2E, 0x0F, 0x33, 0x12, 0x2D, 0x3C, 0x14, 0x27, 0x18, 0x2B, 0x05, 0x06, 0x09, 0x0A,
+		0x10, 0x23, 0x04, 0x15, 0x01, 0x02, 0x37, 0x16, 0x3E, 0x3D, 0x08, 0x19, 0x1F, 0x2C, 0x3B, 0x1A,
+		0x2A, 0x0B, 0x1C, 0x2F, 0x29, 0x38, 0x0D, 0x0E, 0x26, 0x07, 0x32, 0x31, 0x25, 0x34, 0x13, 0x20,
+		0x3A, 0x39, 0x36, 0x35, 0x1B, 0x28, 0x17, 0x24, 0x0C, 0x1D, 0x22, 0x03, 0x3F, 0x1E, 0x21, 0x30
+	};
+	std::uint32_t d = 0, state = 0;
+	for( int shift=14; shift>=0; shift-=2 ) {
+		std::uint32_t entry = TABLE[state | ( x >> shift & 3 ) | ( y >> shift & 3 ) << 2];
+		d = d << 4 | ( entry & 0xF );
+		state = entry & 0x30;
+	}
+	return d;
+}
+
+namespace detail {
+
+/*
+ *  把坐标映射到 [0, 65535]：整数坐标减去下界后按需右移，浮点坐标按包围盒线性缩放
+ */
+template< class Tp, bool INTEGER = std::numeric_limits< Tp >::is_integer >
+struct CurveQuantizer {
+	CurveQuantizer( Tp lo, Tp hi ) : m_lo( lo ), m_scale( hi > lo ? 65535.0 / ( (double)hi - (double)lo ) : 0.0 ) {
+	}
+
+	std::uint32_t operator()( Tp v ) const {
+		double q = ( (double)v - (double)m_lo ) * m_scale;
+		return q < 65535.0 ? (std::uint32_t)q : 65535u;
+	}
+
+	Tp     m_lo;
+	double m_scale;
+};
+
+template< class Tp >
+struct CurveQuantizer< Tp, true > {
+	CurveQuantizer( Tp lo, Tp hi ) : m_lo( lo ), m_shift( 0 ) {
+		std::uint64_t range = (std::uint64_t)( (long long)hi - (long long)lo );
+		while ( ( range >> m_shift ) > 0xFFFF ) {
+			++m_shift;
+		}
+	}
+
+	std::uint32_t operator()( Tp v ) const {
+		return (std::uint32_t)( (std::uint64_t)( (long long)v - (long long)m_lo ) >> m_shift );
+	}
+
+	Tp  m_lo;
+	int m_shift;
+};
+
+template< class Point, class Quantizer >
+void morton_keys( Point const * pts, int begin, int end, Quantizer const & qx, Quantizer const & qy, std::uint32_t * keys ) {
+	for( int i=begin; i<end; ++i ) {
+		keys[i] = morton_key( qx( pts[i].x ), qy( pts[i].y ) );
+	}
+}
+
+#ifdef BR_HAS_X86_SIMD
+/*
+ *  pdep 一条指令完成位交错；部分 AMD Zen 1/2 上 pdep 由微码实现，反而比移位掩码慢
+ */
+template< class Point, class Quantizer >
+BR_TARGET_BMI2 void morton_keys_bmi2( Point const * pts, int begin, int end, Quantizer const & qx, Quantizer const & qy, std::uint32_t * keys ) {
+	for( int i=begin; i<end; ++i ) {
+		keys[i] = _pdep_u32( qx( pts[i].x ), 0x55555555u ) | _pdep_u32( qy( pts[i].y ), 0xAAAAAAAAu );
+	}
+}
+#endif // BR_HAS_X86_SIMD
+
+template< class Point, class Quantizer >
+void hilbert_keys( Point const * pts, int begin, int end, Quantizer const & qx, Quantizer const & qy, std::uint32_t * keys ) {
+	for( int i=begin; i<end; ++i ) {
+		keys[i] = hilbert_key( qx( pts[i].x ), qy( pts[i].y ) );
+	}
+}
+
+} // namespace detail
+
+/*
+ *  @brief 按点集的包围盒把每个点量化到 2^16 x 2^16 网格，并计算其曲线键
+ *  @param  Point  带 x、y 成员与 value_type 的点类型，如 XYPair<int>、Point2D<float>
+ *
+ *  16 位网格对重排局部性已经足够，键只有 32 位，基数排序只需 4 趟。
+ */
+template< class Point >
+void curve_keys( Point const * pts, int n, std::uint32_t * keys, CurveType curve = CURVE_HILBERT, int threads = 0 ) {
+	typedef typename Point::value_type ValType;
+	typedef detail::CurveQuantizer< ValType > Quantizer;
+	int const GRAIN = 1 << 15;  // 每个线程至少处理的点数
+
+	if ( n == 0 ) {
+		return;
+	}
+	threads = detail::work_threads( threads, n, GRAIN );
+	std::vector< Point > lo( threads, pts[0] ), hi( threads, pts[0] );
+	detail::parallel_for( threads, threads, [&]( int begin, int end ) {
+		for( int t=begin; t<end; ++t ) {
+			int last = (int)( (long long)n * ( t + 1 ) / threads );
+			for( int i=(int)( (long long)n * t / threads ); i<last; ++i ) {
+				lo[t].x = std::min( lo[t].x, pts[i].x );
+				lo[t].y = std::min( lo[t].y, pts[i].y );
+				hi[t].x = std::max( hi[t].x, pts[i].x );
+				hi[t].y = std::max( hi[t].y, pts[i].y );
+			}
+		}
+	} );
+	for( int t=1; t<threads; ++t ) {
+		lo[0].x = std::min( lo[0].x, lo[t].x );
+		lo[0].y = std::min( lo[0].y, lo[t].y );
+		hi[0].x = std::max( hi[0].x, hi[t].x );
+		hi[0].y = std::max( hi[0].y, hi[t].y );
+	}
+	Quantizer qx( lo[0].x, hi[0].x ), qy( lo[0].y, hi[0].y );
+
+	detail::parallel_for( n, threads, [&]( int begin, int end ) {
+		if ( curve == CURVE_HILBERT ) {
+			detail::hilbert_keys( pts, begin, end, qx, qy, keys );
+			return;
+		}
+#ifdef BR_HAS_X86_SIMD
+		if ( simd::has_bmi2() ) {
+			detail::morton_keys_bmi2( pts, begin, end, qx, qy, keys );
+			return;
+		}
+#endif // BR_HAS_X86_SIMD
+		detail::morton_keys( pts, begin, end, qx, qy, keys );
+	} );
+}
+
+/*
+ *  @brief 按 keys 对 (keys, ids) 成对做稳定的 LSD 基数排序，每趟 8 位
+ *
+ *  每趟把数组切成若干段由各线程分别计数，按 (数位, 段) 的顺序求前缀和后各自分发，
+ *  因此多线程结果与单线程相同。所有键在某个字节上都相同时跳过该趟。
+ */
+inline void radix_sort( std::uint32_t * keys, int * ids, int n, int threads = 0 ) {
+	int const MIN_CHUNK = 1 << 16;  // 小于此长度的段不值得再开线程
+
+	if ( n < 2 ) {
+		return;
+	}
+	int chunks = detail::work_threads( threads, n, MIN_CHUNK );
+	std::vector< std::uint32_t > key_buf( n );
+	std::vector< int > id_buf( n ), hist( chunks * 256 );
+	std::uint32_t * src_keys = keys, * dst_keys = &key_buf[0];
+	int * src_ids = ids, * dst_ids = &id_buf[0];
+
+	std::uint32_t all_or = 0, all_and = ~0u;
+	for( int i=0; i<n; ++i ) {
+		all_or |= keys[i];
+		all_and &= keys[i];
+	}
+
+	for( int shift=0; shift<32; shift+=8 ) {
+		if ( ( ( all_or ^ all_and ) >> shift & 0xFF ) == 0 ) {
+			continue;
+		}
+		detail::parallel_for( chunks, chunks, [&]( int begin, int end ) {
+			for( int c=begin; c<end; ++c ) {
+				int * h = &hist[c * 256];
+				std::fill( h, h + 256, 0 );
+				int last = (int)( (long long)n * ( c + 1 ) / chunks );
+				for( int i=(int)( (long long)n * c / chunks ); i<last; ++i ) {
+					++h[src_keys[i] >> shift & 0xFF];
+				}
+			}
+		} );
+		int sum = 0;
+		for( int d=0; d<256; ++d ) {
+			for( int c=0; c<chunks; ++c ) {
+				int count = hist[c * 256 + d];
+				hist[c * 256 + d] = sum;
+				sum += count;
+			}
+		}
+		detail::parallel_for( chunks, chunks, [&]( int begin, int end ) {
+			for( int c=begin; c<end; ++c ) {
+				int * h = &hist[c * 256];
+				int last = (int)( (long long)n * ( c + 1 ) / chunks );
+				for( int i=(int)( (long long)n * c / chunks ); i<last; ++i ) {
+					int pos = h[src_keys[i] >> shift & 0xFF]++;
+					dst_keys[pos] = src_keys[i];
+					dst_ids[pos] = src_ids[i];
+				}
+			}
+		} );
+		std::swap( src_keys, dst_keys );
+		std::swap( src_ids, dst_ids );
+	}
+
+	if ( src_keys != keys ) {
+		memcpy( keys, src_keys, sizeof(std::uint32_t) * n );
+		memcpy( ids, src_ids, sizeof(int) * n );
+	}
+}
+
+/*
+ *  order 为按曲线键排序后的点下标，键相同的点保持原有顺序
+ */
+template< class Point >
+void curve_order( Point const * pts, int n, std::vector< int > & order, CurveType curve = CURVE_HILBERT, int threads = 0 ) {
+	order.resize( n );
+	if ( n == 0 ) {
+		return;
+	}
+	std::vector< std::uint32_t > keys( n );
+	curve_keys( pts, n, &keys[0], curve, threads );
+	for( int i=0; i<n; ++i ) {
+		order[i] = i;
+	}
+	radix_sort( &keys[0], &order[0], n, threads );
+}
+
+/*
+ *  把 pts 原地重排为曲线顺序
+ */
+template< class Point >
+void curve_sort( Point * pts, int n, CurveType curve = CURVE_HILBERT, int threads = 0 ) {
+	int const GRAIN = 1 << 15;  // 每个线程至少搬移的点数
+
+	std::vector< int > order;
+	curve_order( pts, n, order, curve, threads );
+	std::vector< Point > sorted( pts, pts + n );
+	detail::parallel_for( n, detail::work_threads( threads, n, GRAIN ), [&]( int begin, int end ) {
+		for( int i=begin; i<end; ++i ) {
+			pts[i] = sorted[order[i]];
+		}
+	} );
+}
+
+}
@@ -0,0 +1,213 @@
+/*
+ * @file  include/spatial/KdTree.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace BR {
+/*
+ *  @brief 静态点集上的二维 k-d 树，按数组存放
+ *  @param  Point  带 x、y 成员与 value_type 的点类型，如 Point2D<double>
+ *  @param  LEAF   不超过该数量的区间不再划分，直接线性扫描
+ *
+ *  没有节点对象：区间 [lo, hi) 的划分点是 m_items[(lo+hi)/2]，左右子树分别是其左右两半，
+ *  build 时用 nth_element 把点原地排成这一顺序，查询时按区间递归，访问的点在内存中相邻。
+ *  每次沿跨度较大的坐标轴划分。点集变化后需要重新 build；动态点集请用 UniformGrid。
+ *  查询结果中的 id 是点在 build 输入数组中的下标。
+ */
+template< class Point, int LEAF = 8 >
+class KdTree {
+public:
+	typedef typename Point::value_type ValType;
+
+	static_assert( LEAF > 0, "LEAF must be positive" );
+
+	KdTree() : m_items(), m_axis() {
+	}
+
+	void build( Point const * pts, int n ) {
+		m_items.resize( n );
+		m_axis.assign( n, 0 );
+		for( int i=0; i<n; ++i ) {
+			m_items[i].p = pts[i];
+			m_items[i].id = i;
+		}
+		build( 0, n );
+	}
+
+	int size() const {
+		return (int)m_items.size();
+	}
+
+	/*
+	 *  最近的 k 个点，按距离从近到远写入 out（覆盖原内容）
+	 */
+	void knn( Point const & center, int k, std::vector< int > & out ) const {
+		out.clear();
+		if ( k <= 0 ) {
+			return;
+		}
+		std::vector< std::pair< ValType, int > > heap;
+		heap.reserve( k + 1 );
+		knn( 0, size(), center, k, heap );
+		std::sort_heap( heap.begin(), heap.end() );
+		for( size_t i=0; i<heap.size(); ++i ) {
+			out.push_back( heap[i].second );
+		}
+	}
+
+	/*
+	 *  把与 center 距离不超过 radius 的点的 id 追加到 out，顺序不确定
+	 */
+	void radius( Point const & center, ValType radius, std::vector< int > & out ) const {
+		this->radius( 0, size(), center, radius * radius, out );
+	}
+
+	/*
+	 *  把落在 [lo, hi] 矩形内的点的 id 追加到 out，顺序不确定
+	 */
+	void box( Point const & lo, Point const & hi, std::vector< int > & out ) const {
+		box( 0, size(), lo, hi, out );
+	}
+
+private:
+	struct Item {
+		Item() : p(), id( 0 ) { }
+
+		Point p;
+		int   id;
+	};
+
+	static ValType coord( Point const & p, int axis ) {
+		return axis == 0 ? p.x : p.y;
+	}
+
+	static ValType dist_sqr( Point const & a, Point const & b ) {
+		ValType dx = a.x - b.x, dy = a.y - b.y;
+		return dx * dx + dy * dy;
+	}
+
+	struct Less {
+		int axis;
+		bool operator()( Item const & lhs, Item const & rhs ) const {
+			return coord( lhs.p, axis ) < coord( rhs.p, axis );
+		}
+	};
+
+	void build( int lo, int hi ) {
+		if ( hi - lo <= LEAF ) {
+			return;
+		}
+		ValType x0 = m_items[lo].p.x, x1 = x0, y0 = m_items[lo].p.y, y1 = y0;
+		for( int i=lo+1; i<hi; ++i ) {
+			Point const & p = m_items[i].p;
+			x0 = std::min( x0, p.x );
+			x1 = std::max( x1, p.x );
+			y0 = std::min( y0, p.y );
+			y1 = std::max( y1, p.y );
+		}
+		int mid = ( lo + hi ) / 2;
+		Less less = { x1 - x0 >= y1 - y0 ? 0 : 1 };
+		std::nth_element( m_items.begin() + lo, m_items.begin() + mid, m_items.begin() + hi, less );
+		m_axis[mid] = (unsigned char)less.axis;
+		build( lo, mid );
+		build( mid + 1, hi );
+	}
+
+	static void push( std::vector< std::pair< ValType, int > > & heap, int k, ValType d, int id ) {
+		if ( (int)heap.size() < k ) {
+			heap.push_back( std::make_pair( d, id ) );
+			std::push_heap( heap.begin(), heap.end() );
+		} else if ( d < heap.front().first ) {
+			std::pop_heap( heap.begin(), heap.end() );
+			heap.back() = std::make_pair( d, id );
+			std::push_heap( heap.begin(), heap.end() );
+		}
+	}
+
+	void knn( int lo, int hi, Point const & center, int k, std::vector< std::pair< ValType, int > > & heap ) const {
+		if ( hi - lo <= LEAF ) {
+			for( int i=lo; i<hi; ++i ) {
+				push( heap, k, dist_sqr( m_items[i].p, center ), m_items[i].id );
+			}
+			return;
+		}
+		int mid = ( lo + hi ) / 2;
+		Item const & split = m_items[mid];
+		ValType d = coord( center, m_axis[mid] ) - coord( split.p, m_axis[mid] );
+		// 先进入查询点所在的一侧，另一侧只在分割线比当前第 k 近更近时才搜索
+		if ( d < 0 ) {
+			knn( lo, mid, center, k, heap );
+		} else {
+			knn( mid + 1, hi, center, k, heap );
+		}
+		push( heap, k, dist_sqr( split.p, center ), split.id );
+		if ( (int)heap.size() < k || d * d < heap.front().first ) {
+			if ( d < 0 ) {
+				knn( mid + 1, hi, center, k, heap );
+			} else {
+				knn( lo, mid, center, k, heap );
+			}
+		}
+	}
+
+	void radius( int lo, int hi, Point const & center, ValType r2, std::vector< int > & out ) const {
+		if ( hi - lo <= LEAF ) {
+			for( int i=lo; i<hi; ++i ) {
+				if ( dist_sqr( m_items[i].p, center ) <= r2 ) {
+					out.push_back( m_items[i].id );
+				}
+			}
+			return;
+		}
+		int mid = ( lo + hi ) / 2;
+		Item const & split = m_items[mid];
+		ValType d = coord( center, m_axis[mid] ) - coord( split.p, m_axis[mid] );
+		if ( dist_sqr( split.p, center ) <= r2 ) {
+			out.push_back( split.id );
+		}
+		if ( d < 0 || d * d <= r2 ) {
+			radius( lo, mid, center, r2, out );
+		}
+		if ( d >= 0 || d * d <= r2 ) {
+			radius( mid + 1, hi, center, r2, out );
+		}
+	}
+
+	void box( int lo, int hi, Point const & bl, Point const & tr, std::vector< int > & out ) const {
+		if ( hi - lo <= LEAF ) {
+			for( int i=lo; i<hi; ++i ) {
+				if ( inside( m_items[i].p, bl, tr ) ) {
+					out.push_back( m_items[i].id );
+				}
+			}
+			return;
+		}
+		int mid = ( lo + hi ) / 2;
+		Item const & split = m_items[mid];
+		int axis = m_axis[mid];
+		if ( inside( split.p, bl, tr ) ) {
+			out.push_back( split.id );
+		}
+		if ( coord( bl, axis ) <= coord( split.p, axis ) ) {
+			box( lo, mid, bl, tr, out );
+		}
+		if ( coord( tr, axis ) >= coord( split.p, axis ) ) {
+			box( mid + 1, hi, bl, tr, out );
+		}
+	}
+
+	static bool inside( Point const & p, Point const & bl, Point const & tr ) {
+		return p.x >= bl.x && p.x <= tr.x && p.y >= bl.y && p.y <= tr.y;
+	}
+
+	std::vector< Item >          m_items;  // 按 k-d 树顺序排列的点
+	std::vector< unsigned char > m_axis;   // m_axis[mid] 为区间划分点所用的坐标轴
+};
+
+}
@@ -0,0 +1,178 @@
+/*
+ * @file  include/spatial/RTree.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <math/AABB2D.hpp>
+#include <concurrent/Parallel.hpp>
+
+namespace BR {
+/*
+ *  @brief 批量构建的静态 R 树，索引 AABB2D
+ *  @param  FANOUT  每个节点的子节点数
+ *
+ *  用 STR（Sort-Tile-Recursive）装填：按中心 x 排序后切成约 sqrt(叶子数) 个竖条，
+ *  每条内再按中心 y 排序，连续的 FANOUT 个盒子组成一个叶子。
+ *  节点没有指针：第 l 层是一个连续的盒子数组，第 l 层第 j 个节点的子节点是
+ *  第 l-1 层的 [j*FANOUT, (j+1)*FANOUT)，第 0 层即输入的盒子，查询时同层兄弟在内存中相邻。
+ *  两次排序与各层合并都按 threads 个线程并行，0 表示使用全部硬件线程；
+ *  每个线程至少分到 GRAIN 个盒子（或查询），输入较少时在当前线程完成。
+ *  查询结果中的 id 是盒子在 build 输入数组中的下标。
+ */
+template< class Tp, int FANOUT = 16 >
+class RTree {
+public:
+	typedef AABB2D< Tp > Box;
+
+	static_assert( FANOUT >= 2, "FANOUT must be at least 2" );
+
+	RTree() : m_levels(), m_ids() {
+	}
+
+	void build( Box const * boxes, int n, int threads = 0 ) {
+		threads = detail::work_threads( threads, n, GRAIN );
+		m_levels.clear();
+		m_ids.clear();
+		if ( n == 0 ) {
+			return;
+		}
+
+		std::vector< Entry > entries( n );
+		detail::parallel_for( n, threads, [&]( int begin, int end ) {
+			for( int i=begin; i<end; ++i ) {
+				entries[i].box = boxes[i];
+				entries[i].id = i;
+			}
+		} );
+
+		detail::parallel_sort( entries.begin(), entries.end(), LessX(), threads );
+		int leaves = ( n + FANOUT - 1 ) / FANOUT;
+		int slices = (int)std::ceil( std::sqrt( (double)leaves ) );
+		int slice_size = ( ( leaves + slices - 1 ) / slices ) * FANOUT;
+		int slice_count = ( n + slice_size - 1 ) / slice_size;
+		detail::parallel_for( slice_count, threads, [&]( int begin, int end ) {
+			for( int s=begin; s<end; ++s ) {
+				int lo = s * slice_size;
+				int hi = std::min( lo + slice_size, n );
+				std::sort( entries.begin() + lo, entries.begin() + hi, LessY() );
+			}
+		} );
+
+		m_levels.push_back( std::vector< Box >( n ) );
+		m_ids.resize( n );
+		detail::parallel_for( n, threads, [&]( int begin, int end ) {
+			for( int i=begin; i<end; ++i ) {
+				m_levels[0][i] = entries[i].box;
+				m_ids[i] = entries[i].id;
+			}
+		} );
+
+		while ( m_levels.back().size() > 1 ) {
+			std::vector< Box > const & below = m_levels.back();
+			int count = (int)below.size();
+			std::vector< Box > level( ( count + FANOUT - 1 ) / FANOUT );
+			// 每个上层节点合并 FANOUT 个盒子
+			int level_threads = detail::work_threads( threads, count, GRAIN );
+			detail::parallel_for( (int)level.size(), level_threads, [&]( int begin, int end ) {
+				for( int j=begin; j<end; ++j ) {
+					int hi = std::min( ( j + 1 ) * FANOUT, count );
+					Box box = below[j * FANOUT];
+					for( int c=j*FANOUT+1; c<hi; ++c ) {
+						box.merge( below[c] );
+					}
+					level[j] = box;
+				}
+			} );
+			m_levels.push_back( level );
+		}
+	}
+
+	int size() const {
+		return (int)m_ids.size();
+	}
+
+	/*
+	 *  对每个与 q 重叠的盒子调用 fn( id )
+	 */
+	template< class Fn >
+	void visit( Box const & q, Fn fn ) const {
+		if ( m_levels.empty() ) {
+			return;
+		}
+		int top = (int)m_levels.size() - 1;
+		for( int i=0; i<(int)m_levels[top].size(); ++i ) {
+			visit( top, i, q, fn );
+		}
+	}
+
+	/*
+	 *  把与 q 重叠的盒子的 id 追加到 out，顺序不确定
+	 */
+	void query( Box const & q, std::vector< int > & out ) const {
+		visit( q, [&]( int id ) {
+			out.push_back( id );
+		} );
+	}
+
+	/*
+	 *  并行执行 n 个查询，out[i] 为 qs[i] 的结果（覆盖原内容）
+	 */
+	void query_batch( Box const * qs, int n, std::vector< std::vector< int > > & out, int threads = 0 ) const {
+		out.resize( n );
+		detail::parallel_for( n, detail::work_threads( threads, n, QUERY_GRAIN ), [&]( int begin, int end ) {
+			for( int i=begin; i<end; ++i ) {
+				out[i].clear();
+				query( qs[i], out[i] );
+			}
+		} );
+	}
+
+private:
+	static int const GRAIN = 1 << 14;        // 构建时每个线程至少处理的盒子数
+	static int const QUERY_GRAIN = 1 << 8;   // 批量查询时每个线程至少处理的查询数
+
+	struct Entry {
+		Entry() : box(), id( 0 ) { }
+
+		Box box;
+		int id;
+	};
+
+	struct LessX {
+		bool operator()( Entry const & lhs, Entry const & rhs ) const {
+			return lhs.box.center2().x < rhs.box.center2().x;
+		}
+	};
+
+	struct LessY {
+		bool operator()( Entry const & lhs, Entry const & rhs ) const {
+			return lhs.box.center2().y < rhs.box.center2().y;
+		}
+	};
+
+	template< class Fn >
+	void visit( int level, int i, Box const & q, Fn & fn ) const {
+		if ( !m_levels[level][i].overlaps( q ) ) {
+			return;
+		}
+		if ( level == 0 ) {
+			fn( m_ids[i] );
+			return;
+		}
+		int hi = std::min( ( i + 1 ) * FANOUT, (int)m_levels[level-1].size() );
+		for( int c=i*FANOUT; c<hi; ++c ) {
+			visit( level - 1, c, q, fn );
+		}
+	}
+
+	std::vector< std::vector< Box > > m_levels;  // m_levels[0] 为按 STR 顺序排列的输入盒子，末层只有根
+	std::vector< int >                m_ids;     // m_ids[i] 为 m_levels[0][i] 的输入下标
+};
+
+}
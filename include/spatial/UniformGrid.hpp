@@ -0,0 +1,277 @@
+/*
+ * @file  include/spatial/UniformGrid.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include HEADER_STDINT
+
+#include <structure/FlatHashMapPOD.hpp>
+
+namespace BR {
+/*
+ *  @brief 均匀网格空间哈希，适合每帧都在移动的点集
+ *  @param  Point  带 x、y 成员与 value_type 的点类型，如 Point2D<double>
+ *
+ *  平面按 cell_size 划分成正方形格子，只为非空格子在 FlatHashMapPOD 中保存链表头；
+ *  每个点在所在格子的双向链表中，插入、删除、移动都是 O(1)。
+ *  点由调用者给出的非负整数 id 标识，id 应尽量稠密，内部按最大 id 分配数组。
+ *  cell_size 取查询半径的量级时效果最好。
+ */
+template< class Point >
+class UniformGrid {
+public:
+	typedef typename Point::value_type ValType;
+
+	explicit UniformGrid( ValType cell_size ) :
+		m_inv_cell( ValType( 1 ) / cell_size ), m_cell( cell_size ), m_cells(), m_pos(), m_key(), m_next(), m_prev(), m_live(), m_size( 0 ) {
+		BR_ASSERT( cell_size > 0 );
+	}
+
+	/*
+	 *  清空后批量插入，pts[i] 的 id 为 i
+	 */
+	void build( Point const * pts, int n ) {
+		clear();
+		grow( n );
+		m_cells.reserve( n );
+		for( int i=0; i<n; ++i ) {
+			insert( i, pts[i] );
+		}
+	}
+
+	void insert( int id, Point const & p ) {
+		BR_ASSERT( id >= 0 );
+		grow( id + 1 );
+		BR_ASSERT( !m_live[id] );
+		m_pos[id] = p;
+		link( id, key_of( p ) );
+		m_live[id] = 1;
+		++m_size;
+	}
+
+	void remove( int id ) {
+		BR_ASSERT( contains( id ) );
+		unlink( id );
+		m_live[id] = 0;
+		--m_size;
+	}
+
+	/*
+	 *  更新点的位置，仍在原格子中时只改坐标
+	 */
+	void move( int id, Point const & p ) {
+		BR_ASSERT( contains( id ) );
+		std::uint64_t key = key_of( p );
+		if ( key != m_key[id] ) {
+			unlink( id );
+			link( id, key );
+		}
+		m_pos[id] = p;
+	}
+
+	bool contains( int id ) const {
+		return id >= 0 && id < (int)m_live.size() && m_live[id];
+	}
+
+	Point const & position( int id ) const {
+		BR_ASSERT( contains( id ) );
+		return m_pos[id];
+	}
+
+	void clear() {
+		m_cells.clear();
+		std::fill( m_live.begin(), m_live.end(), 0 );
+		m_size = 0;
+	}
+
+	int size() const {
+		return m_size;
+	}
+
+	/*
+	 *  把与 center 距离不超过 radius 的点的 id 追加到 out，顺序不确定
+	 */
+	void radius( Point const & center, ValType radius, std::vector< int > & out ) const {
+		ValType r2 = radius * radius;
+		visit_box( center.x - radius, center.y - radius, center.x + radius, center.y + radius, [&]( int id ) {
+			if ( dist_sqr( m_pos[id], center ) <= r2 ) {
+				out.push_back( id );
+			}
+		} );
+	}
+
+	/*
+	 *  把落在 [lo, hi] 矩形内的点的 id 追加到 out，顺序不确定
+	 */
+	void box( Point const & lo, Point const & hi, std::vector< int > & out ) const {
+		visit_box( lo.x, lo.y, hi.x, hi.y, [&]( int id ) {
+			Point const & p = m_pos[id];
+			if ( p.x >= lo.x && p.x <= hi.x && p.y >= lo.y && p.y <= hi.y ) {
+				out.push_back( id );
+			}
+		} );
+	}
+
+	/*
+	 *  最近的 k 个点，按距离从近到远写入 out（覆盖原内容）
+	 *
+	 *  以查询点所在格子为中心逐圈向外搜索：第 r 圈之外的点距离至少为 r * cell_size，
+	 *  已找到 k 个且第 k 近的点不超过该距离时停止；圈数过大时退化为遍历所有非空格子。
+	 */
+	void knn( Point const & center, int k, std::vector< int > & out ) const {
+		out.clear();
+		if ( k <= 0 || m_size == 0 ) {
+			return;
+		}
+		std::vector< std::pair< ValType, int > > heap;
+		heap.reserve( k + 1 );
+		auto consider = [&]( int id ) {
+			ValType d = dist_sqr( m_pos[id], center );
+			if ( (int)heap.size() < k ) {
+				heap.push_back( std::make_pair( d, id ) );
+				std::push_heap( heap.begin(), heap.end() );
+			} else if ( d < heap.front().first ) {
+				std::pop_heap( heap.begin(), heap.end() );
+				heap.back() = std::make_pair( d, id );
+				std::push_heap( heap.begin(), heap.end() );
+			}
+		};
+
+		int cx = cell_coord( center.x ), cy = cell_coord( center.y );
+		int seen = 0;
+		for( int r=0; ; ++r ) {
+			if ( (long long)( 2*r + 1 ) * ( 2*r + 1 ) > 4LL * m_cells.size() ) {
+				// 环太大，直接遍历全部非空格子；前面已访问的格子会重复计入，先清空
+				heap.clear();
+				m_cells.for_each( [&]( std::uint64_t const &, int const & head ) {
+					for( int id=head; id>=0; id=m_next[id] ) {
+						consider( id );
+					}
+				} );
+				break;
+			}
+			for( int dy=-r; dy<=r; ++dy ) {
+				// 第 r 圈：首末两行取整行，中间各行只取两端
+				int step = ( dy == -r || dy == r ) ? 1 : 2 * r;
+				for( int dx=-r; dx<=r; dx+=step ) {
+					for( int id=head_of( cx + dx, cy + dy ); id>=0; id=m_next[id] ) {
+						consider( id );
+						++seen;
+					}
+				}
+			}
+			if ( seen == m_size ) {
+				break;
+			}
+			ValType reach = r * m_cell;
+			if ( (int)heap.size() == k && heap.front().first <= reach * reach ) {
+				break;
+			}
+		}
+		std::sort_heap( heap.begin(), heap.end() );
+		for( size_t i=0; i<heap.size(); ++i ) {
+			out.push_back( heap[i].second );
+		}
+	}
+
+private:
+	static ValType dist_sqr( Point const & a, Point const & b ) {
+		ValType dx = a.x - b.x, dy = a.y - b.y;
+		return dx * dx + dy * dy;
+	}
+
+	int cell_coord( ValType v ) const {
+		return (int)std::floor( v * m_inv_cell );
+	}
+
+	static std::uint64_t pack( int cx, int cy ) {
+		return ( std::uint64_t( std::uint32_t( cx ) ) << 32 ) | std::uint32_t( cy );
+	}
+
+	std::uint64_t key_of( Point const & p ) const {
+		return pack( cell_coord( p.x ), cell_coord( p.y ) );
+	}
+
+	int head_of( int cx, int cy ) const {
+		int const * head = m_cells.find( pack( cx, cy ) );
+		return head == BR_NULLPTR ? -1 : *head;
+	}
+
+	template< class Fn >
+	void visit_box( ValType x0, ValType y0, ValType x1, ValType y1, Fn fn ) const {
+		int cx0 = cell_coord( x0 ), cy0 = cell_coord( y0 );
+		int cx1 = cell_coord( x1 ), cy1 = cell_coord( y1 );
+		if ( (long long)( cx1 - cx0 + 1 ) * ( cy1 - cy0 + 1 ) > 2LL * m_cells.size() ) {
+			// 覆盖的格子比非空格子还多时，改为遍历非空格子
+			m_cells.for_each( [&]( std::uint64_t const &, int const & head ) {
+				for( int id=head; id>=0; id=m_next[id] ) {
+					fn( id );
+				}
+			} );
+			return;
+		}
+		for( int cy=cy0; cy<=cy1; ++cy ) {
+			for( int cx=cx0; cx<=cx1; ++cx ) {
+				for( int id=head_of( cx, cy ); id>=0; id=m_next[id] ) {
+					fn( id );
+				}
+			}
+		}
+	}
+
+	void grow( int n ) {
+		if ( n > (int)m_live.size() ) {
+			m_pos.resize( n );
+			m_key.resize( n );
+			m_next.resize( n );
+			m_prev.resize( n );
+			m_live.resize( n, 0 );
+		}
+	}
+
+	void link( int id, std::uint64_t key ) {
+		m_key[id] = key;
+		m_prev[id] = -1;
+		int * head = m_cells.find( key );
+		if ( head == BR_NULLPTR ) {
+			m_next[id] = -1;
+			m_cells.insert( key, id );
+		} else {
+			m_next[id] = *head;
+			m_prev[*head] = id;
+			*head = id;
+		}
+	}
+
+	void unlink( int id ) {
+		if ( m_next[id] >= 0 ) {
+			m_prev[m_next[id]] = m_prev[id];
+		}
+		if ( m_prev[id] >= 0 ) {
+			m_next[m_prev[id]] = m_next[id];
+		} else if ( m_next[id] >= 0 ) {
+			*m_cells.find( m_key[id] ) = m_next[id];
+		} else {
+			m_cells.erase( m_key[id] );
+		}
+	}
+
+	ValType                              m_inv_cell;
+	ValType                              m_cell;
+	FlatHashMapPOD< std::uint64_t, int > m_cells;  // 非空格子 -> 链表头
+	std::vector< Point >                 m_pos;
+	std::vector< std::uint64_t >         m_key;    // 点所在格子
+	std::vector< int >                   m_next;
+	std::vector< int >                   m_prev;
+	std::vector< unsigned char >         m_live;
+	int                                  m_size;
+};
+
+}
@@ -0,0 +1,628 @@
+﻿/*
+ * @file  include/structure/BulkPOD.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <type_traits>
+
+#include <simd/CpuFeatures.hpp>
+#include <structure/DynArrPOD.hpp>
+
+namespace BR {
+/*
+ *  @brief 批量算法的累加类型：float/double 累加到 double，long double 累加到 long double，
+ *  无符号整数累加到 unsigned long long，有符号整数累加到 long long
+ */
+template< class Tp >
+struct BulkSumType {
+	static_assert( std::is_arithmetic< Tp >::value, "bulk_sum needs an arithmetic type" );
+
+	typedef typename std::conditional< std::is_floating_point< Tp >::value,
+		typename std::conditional< std::is_same< Tp, long double >::value, long double, double >::type,
+		typename std::conditional< std::is_unsigned< Tp >::value, unsigned long long, long long >::type
+	>::type type;
+};
+
+namespace detail {
+
+template< class Tp >
+typename BulkSumType< Tp >::type bulk_sum_scalar( Tp const * mem, int n ) {
+	typename BulkSumType< Tp >::type sum = 0;
+	for( int i=0; i<n; ++i ) {
+		sum += mem[i];
+	}
+	return sum;
+}
+
+template< class Tp >
+Tp bulk_min_scalar( Tp const * mem, int n ) {
+	BR_ASSERT( n > 0 );
+	Tp result = mem[0];
+	for( int i=1; i<n; ++i ) {
+		if ( mem[i] < result ) {
+			result = mem[i];
+		}
+	}
+	return result;
+}
+
+template< class Tp >
+Tp bulk_max_scalar( Tp const * mem, int n ) {
+	BR_ASSERT( n > 0 );
+	Tp result = mem[0];
+	for( int i=1; i<n; ++i ) {
+		if ( result < mem[i] ) {
+			result = mem[i];
+		}
+	}
+	return result;
+}
+
+template< class Tp >
+int bulk_find_scalar( Tp const * mem, int n, Tp value, int from = 0 ) {
+	for( int i=from; i<n; ++i ) {
+		if ( mem[i] == value ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+template< class Tp >
+int bulk_count_scalar( Tp const * mem, int n, Tp value, int from = 0 ) {
+	int result = 0;
+	for( int i=from; i<n; ++i ) {
+		result += mem[i] == value;
+	}
+	return result;
+}
+
+template< class Tp >
+void bulk_fill_scalar( Tp * mem, int n, Tp value, int from = 0 ) {
+	for( int i=from; i<n; ++i ) {
+		mem[i] = value;
+	}
+}
+
+template< class Tp >
+void bulk_add_scalar( Tp * mem, int n, Tp value, int from = 0 ) {
+	for( int i=from; i<n; ++i ) {
+		mem[i] += value;
+	}
+}
+
+template< class Tp >
+void bulk_axpy_scalar( Tp * dst, Tp const * src, int n, Tp k, int from = 0 ) {
+	for( int i=from; i<n; ++i ) {
+		dst[i] += src[i] * k;
+	}
+}
+
+#ifdef BR_HAS_X86_SIMD
+/*
+ *  SSE2 版本（x86-64 上总是可用）
+ */
+inline double bulk_sum_sse2( float const * mem, int n ) {
+	__m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m128 v = _mm_loadu_ps( mem + i );
+		acc0 = _mm_add_pd( acc0, _mm_cvtps_pd( v ) );
+		acc1 = _mm_add_pd( acc1, _mm_cvtps_pd( _mm_movehl_ps( v, v ) ) );
+	}
+	double lanes[2];
+	_mm_storeu_pd( lanes, _mm_add_pd( acc0, acc1 ) );
+	return lanes[0] + lanes[1] + bulk_sum_scalar( mem + i, n - i );
+}
+
+inline long long bulk_sum_sse2( int const * mem, int n ) {
+	__m128i acc = _mm_setzero_si128();
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m128i v = _mm_loadu_si128( (__m128i const *)( mem + i ) );
+		__m128i sign = _mm_srai_epi32( v, 31 );
+		acc = _mm_add_epi64( acc, _mm_unpacklo_epi32( v, sign ) );
+		acc = _mm_add_epi64( acc, _mm_unpackhi_epi32( v, sign ) );
+	}
+	long long lanes[2];
+	_mm_storeu_si128( (__m128i *)lanes, acc );
+	return lanes[0] + lanes[1] + bulk_sum_scalar( mem + i, n - i );
+}
+
+inline float bulk_min_sse2( float const * mem, int n ) {
+	if ( n < 4 ) {
+		return bulk_min_scalar( mem, n );
+	}
+	__m128 acc = _mm_loadu_ps( mem );
+	int i = 4;
+	for( ; i+4<=n; i+=4 ) {
+		acc = _mm_min_ps( acc, _mm_loadu_ps( mem + i ) );
+	}
+	// 尾部用最后 4 个元素补齐，重复比较不影响结果
+	acc = _mm_min_ps( acc, _mm_loadu_ps( mem + n - 4 ) );
+	float lanes[4];
+	_mm_storeu_ps( lanes, acc );
+	return bulk_min_scalar( lanes, 4 );
+}
+
+inline float bulk_max_sse2( float const * mem, int n ) {
+	if ( n < 4 ) {
+		return bulk_max_scalar( mem, n );
+	}
+	__m128 acc = _mm_loadu_ps( mem );
+	int i = 4;
+	for( ; i+4<=n; i+=4 ) {
+		acc = _mm_max_ps( acc, _mm_loadu_ps( mem + i ) );
+	}
+	acc = _mm_max_ps( acc, _mm_loadu_ps( mem + n - 4 ) );
+	float lanes[4];
+	_mm_storeu_ps( lanes, acc );
+	return bulk_max_scalar( lanes, 4 );
+}
+
+// SSE2 没有 32 位整数的 min/max，用比较加按位选择代替
+inline __m128i select_sse2( __m128i mask, __m128i a, __m128i b ) {
+	return _mm_or_si128( _mm_and_si128( mask, a ), _mm_andnot_si128( mask, b ) );
+}
+
+inline int bulk_min_sse2( int const * mem, int n ) {
+	if ( n < 4 ) {
+		return bulk_min_scalar( mem, n );
+	}
+	__m128i acc = _mm_loadu_si128( (__m128i const *)mem );
+	int i = 4;
+	for( ; i+4<=n; i+=4 ) {
+		__m128i v = _mm_loadu_si128( (__m128i const *)( mem + i ) );
+		acc = select_sse2( _mm_cmplt_epi32( v, acc ), v, acc );
+	}
+	__m128i v = _mm_loadu_si128( (__m128i const *)( mem + n - 4 ) );
+	acc = select_sse2( _mm_cmplt_epi32( v, acc ), v, acc );
+	int lanes[4];
+	_mm_storeu_si128( (__m128i *)lanes, acc );
+	return bulk_min_scalar( lanes, 4 );
+}
+
+inline int bulk_max_sse2( int const * mem, int n ) {
+	if ( n < 4 ) {
+		return bulk_max_scalar( mem, n );
+	}
+	__m128i acc = _mm_loadu_si128( (__m128i const *)mem );
+	int i = 4;
+	for( ; i+4<=n; i+=4 ) {
+		__m128i v = _mm_loadu_si128( (__m128i const *)( mem + i ) );
+		acc = select_sse2( _mm_cmpgt_epi32( v, acc ), v, acc );
+	}
+	__m128i v = _mm_loadu_si128( (__m128i const *)( mem + n - 4 ) );
+	acc = select_sse2( _mm_cmpgt_epi32( v, acc ), v, acc );
+	int lanes[4];
+	_mm_storeu_si128( (__m128i *)lanes, acc );
+	return bulk_max_scalar( lanes, 4 );
+}
+
+inline int bulk_find_sse2( float const * mem, int n, float value ) {
+	__m128 key = _mm_set1_ps( value );
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		int mask = _mm_movemask_ps( _mm_cmpeq_ps( _mm_loadu_ps( mem + i ), key ) );
+		if ( mask != 0 ) {
+			return i + __builtin_ctz( mask );
+		}
+	}
+	return bulk_find_scalar( mem, n, value, i );
+}
+
+inline int bulk_find_sse2( int const * mem, int n, int value ) {
+	__m128i key = _mm_set1_epi32( value );
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		__m128i eq = _mm_cmpeq_epi32( _mm_loadu_si128( (__m128i const *)( mem + i ) ), key );
+		int mask = _mm_movemask_ps( _mm_castsi128_ps( eq ) );
+		if ( mask != 0 ) {
+			return i + __builtin_ctz( mask );
+		}
+	}
+	return bulk_find_scalar( mem, n, value, i );
+}
+
+// 相等的通道为 -1，累减即得计数
+inline int bulk_count_sse2( float const * mem, int n, float value ) {
+	__m128 key = _mm_set1_ps( value );
+	__m128i acc = _mm_setzero_si128();
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		acc = _mm_sub_epi32( acc, _mm_castps_si128( _mm_cmpeq_ps( _mm_loadu_ps( mem + i ), key ) ) );
+	}
+	int lanes[4];
+	_mm_storeu_si128( (__m128i *)lanes, acc );
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + bulk_count_scalar( mem, n, value, i );
+}
+
+inline int bulk_count_sse2( int const * mem, int n, int value ) {
+	__m128i key = _mm_set1_epi32( value );
+	__m128i acc = _mm_setzero_si128();
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		acc = _mm_sub_epi32( acc, _mm_cmpeq_epi32( _mm_loadu_si128( (__m128i const *)( mem + i ) ), key ) );
+	}
+	int lanes[4];
+	_mm_storeu_si128( (__m128i *)lanes, acc );
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + bulk_count_scalar( mem, n, value, i );
+}
+
+inline void bulk_fill_sse2( float * mem, int n, float value ) {
+	__m128 v = _mm_set1_ps( value );
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		_mm_storeu_ps( mem + i, v );
+	}
+	bulk_fill_scalar( mem, n, value, i );
+}
+
+inline void bulk_fill_sse2( int * mem, int n, int value ) {
+	__m128i v = _mm_set1_epi32( value );
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		_mm_storeu_si128( (__m128i *)( mem + i ), v );
+	}
+	bulk_fill_scalar( mem, n, value, i );
+}
+
+inline void bulk_add_sse2( float * mem, int n, float value ) {
+	__m128 v = _mm_set1_ps( value );
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		_mm_storeu_ps( mem + i, _mm_add_ps( _mm_loadu_ps( mem + i ), v ) );
+	}
+	bulk_add_scalar( mem, n, value, i );
+}
+
+inline void bulk_axpy_sse2( float * dst, float const * src, int n, float k ) {
+	__m128 vk = _mm_set1_ps( k );
+	int i = 0;
+	for( ; i+4<=n; i+=4 ) {
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_loadu_ps( dst + i ), _mm_mul_ps( _mm_loadu_ps( src + i ), vk ) ) );
+	}
+	bulk_axpy_scalar( dst, src, n, k, i );
+}
+
+/*
+ *  AVX2 版本，运行时检测到 AVX2 时才调用
+ */
+BR_TARGET_AVX2 inline double bulk_sum_avx2( float const * mem, int n ) {
+	__m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		acc0 = _mm256_add_pd( acc0, _mm256_cvtps_pd( _mm_loadu_ps( mem + i ) ) );
+		acc1 = _mm256_add_pd( acc1, _mm256_cvtps_pd( _mm_loadu_ps( mem + i + 4 ) ) );
+	}
+	double lanes[4];
+	_mm256_storeu_pd( lanes, _mm256_add_pd( acc0, acc1 ) );
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + bulk_sum_scalar( mem + i, n - i );
+}
+
+BR_TARGET_AVX2 inline long long bulk_sum_avx2( int const * mem, int n ) {
+	__m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		acc0 = _mm256_add_epi64( acc0, _mm256_cvtepi32_epi64( _mm_loadu_si128( (__m128i const *)( mem + i ) ) ) );
+		acc1 = _mm256_add_epi64( acc1, _mm256_cvtepi32_epi64( _mm_loadu_si128( (__m128i const *)( mem + i + 4 ) ) ) );
+	}
+	long long lanes[4];
+	_mm256_storeu_si256( (__m256i *)lanes, _mm256_add_epi64( acc0, acc1 ) );
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + bulk_sum_scalar( mem + i, n - i );
+}
+
+BR_TARGET_AVX2 inline float bulk_min_avx2( float const * mem, int n ) {
+	if ( n < 8 ) {
+		return bulk_min_sse2( mem, n );
+	}
+	__m256 acc = _mm256_loadu_ps( mem );
+	for( int i=8; i+8<=n; i+=8 ) {
+		acc = _mm256_min_ps( acc, _mm256_loadu_ps( mem + i ) );
+	}
+	acc = _mm256_min_ps( acc, _mm256_loadu_ps( mem + n - 8 ) );
+	float lanes[8];
+	_mm256_storeu_ps( lanes, acc );
+	return bulk_min_scalar( lanes, 8 );
+}
+
+BR_TARGET_AVX2 inline float bulk_max_avx2( float const * mem, int n ) {
+	if ( n < 8 ) {
+		return bulk_max_sse2( mem, n );
+	}
+	__m256 acc = _mm256_loadu_ps( mem );
+	for( int i=8; i+8<=n; i+=8 ) {
+		acc = _mm256_max_ps( acc, _mm256_loadu_ps( mem + i ) );
+	}
+	acc = _mm256_max_ps( acc, _mm256_loadu_ps( mem + n - 8 ) );
+	float lanes[8];
+	_mm256_storeu_ps( lanes, acc );
+	return bulk_max_scalar( lanes, 8 );
+}
+
+BR_TARGET_AVX2 inline int bulk_min_avx2( int const * mem, int n ) {
+	if ( n < 8 ) {
+		return bulk_min_sse2( mem, n );
+	}
+	__m256i acc = _mm256_loadu_si256( (__m256i const *)mem );
+	for( int i=8; i+8<=n; i+=8 ) {
+		acc = _mm256_min_epi32( acc, _mm256_loadu_si256( (__m256i const *)( mem + i ) ) );
+	}
+	acc = _mm256_min_epi32( acc, _mm256_loadu_si256( (__m256i const *)( mem + n - 8 ) ) );
+	int lanes[8];
+	_mm256_storeu_si256( (__m256i *)lanes, acc );
+	return bulk_min_scalar( lanes, 8 );
+}
+
+BR_TARGET_AVX2 inline int bulk_max_avx2( int const * mem, int n ) {
+	if ( n < 8 ) {
+		return bulk_max_sse2( mem, n );
+	}
+	__m256i acc = _mm256_loadu_si256( (__m256i const *)mem );
+	for( int i=8; i+8<=n; i+=8 ) {
+		acc = _mm256_max_epi32( acc, _mm256_loadu_si256( (__m256i const *)( mem + i ) ) );
+	}
+	acc = _mm256_max_epi32( acc, _mm256_loadu_si256( (__m256i const *)( mem + n - 8 ) ) );
+	int lanes[8];
+	_mm256_storeu_si256( (__m256i *)lanes, acc );
+	return bulk_max_scalar( lanes, 8 );
+}
+
+BR_TARGET_AVX2 inline int bulk_find_avx2( float const * mem, int n, float value ) {
+	__m256 key = _mm256_set1_ps( value );
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		int mask = _mm256_movemask_ps( _mm256_cmp_ps( _mm256_loadu_ps( mem + i ), key, _CMP_EQ_OQ ) );
+		if ( mask != 0 ) {
+			return i + __builtin_ctz( mask );
+		}
+	}
+	return bulk_find_scalar( mem, n, value, i );
+}
+
+BR_TARGET_AVX2 inline int bulk_find_avx2( int const * mem, int n, int value ) {
+	__m256i key = _mm256_set1_epi32( value );
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		__m256i eq = _mm256_cmpeq_epi32( _mm256_loadu_si256( (__m256i const *)( mem + i ) ), key );
+		int mask = _mm256_movemask_ps( _mm256_castsi256_ps( eq ) );
+		if ( mask != 0 ) {
+			return i + __builtin_ctz( mask );
+		}
+	}
+	return bulk_find_scalar( mem, n, value, i );
+}
+
+BR_TARGET_AVX2 inline int bulk_count_avx2( float const * mem, int n, float value ) {
+	__m256 key = _mm256_set1_ps( value );
+	__m256i acc = _mm256_setzero_si256();
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		acc = _mm256_sub_epi32( acc, _mm256_castps_si256( _mm256_cmp_ps( _mm256_loadu_ps( mem + i ), key, _CMP_EQ_OQ ) ) );
+	}
+	int lanes[8];
+	_mm256_storeu_si256( (__m256i *)lanes, acc );
+	int result = bulk_count_scalar( mem, n, value, i );
+	for( int j=0; j<8; ++j ) {
+		result += lanes[j];
+	}
+	return result;
+}
+
+BR_TARGET_AVX2 inline int bulk_count_avx2( int const * mem, int n, int value ) {
+	__m256i key = _mm256_set1_epi32( value );
+	__m256i acc = _mm256_setzero_si256();
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		acc = _mm256_sub_epi32( acc, _mm256_cmpeq_epi32( _mm256_loadu_si256( (__m256i const *)( mem + i ) ), key ) );
+	}
+	int lanes[8];
+	_mm256_storeu_si256( (__m256i *)lanes, acc );
+	int result = bulk_count_scalar( mem, n, value, i );
+	for( int j=0; j<8; ++j ) {
+		result += lanes[j];
+	}
+	return result;
+}
+
+BR_TARGET_AVX2 inline void bulk_fill_avx2( float * mem, int n, float value ) {
+	__m256 v = _mm256_set1_ps( value );
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		_mm256_storeu_ps( mem + i, v );
+	}
+	bulk_fill_scalar( mem, n, value, i );
+}
+
+BR_TARGET_AVX2 inline void bulk_fill_avx2( int * mem, int n, int value ) {
+	__m256i v = _mm256_set1_epi32( value );
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		_mm256_storeu_si256( (__m256i *)( mem + i ), v );
+	}
+	bulk_fill_scalar( mem, n, value, i );
+}
+
+BR_TARGET_AVX2 inline void bulk_add_avx2( float * mem, int n, float value ) {
+	__m256 v = _mm256_set1_ps( value );
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		_mm256_storeu_ps( mem + i, _mm256_add_ps( _mm256_loadu_ps( mem + i ), v ) );
+	}
+	bulk_add_scalar( mem, n, value, i );
+}
+
+// 不使用 FMA：保证与标量及 SSE2 版本的结果逐位一致
+BR_TARGET_AVX2 inline void bulk_axpy_avx2( float * dst, float const * src, int n, float k ) {
+	__m256 vk = _mm256_set1_ps( k );
+	int i = 0;
+	for( ; i+8<=n; i+=8 ) {
+		_mm256_storeu_ps( dst + i, _mm256_add_ps( _mm256_loadu_ps( dst + i ), _mm256_mul_ps( _mm256_loadu_ps( src + i ), vk ) ) );
+	}
+	bulk_axpy_scalar( dst, src, n, k, i );
+}
+#endif // BR_HAS_X86_SIMD
+
+} // namespace detail
+
+/*
+ *  @brief 批量求和、最值、查找、计数与填充
+ *
+ *  bulk_add 给每个元素加上 value，bulk_axpy 计算 dst[i] += src[i] * k，
+ *  两者目前只对 float 有 SIMD 实现；其余 float 与 int 有 SSE2/AVX2 实现，按运行时检测到的指令集分派，其他类型使用标量循环。
+ *  浮点求和按向量通道分组累加到 double，结果可能与顺序累加有舍入差异；
+ *  min/max 要求 n > 0，且不处理 NaN。find 返回第一个相等元素的下标，没有时返回 -1。
+ */
+template< class Tp >
+inline typename BulkSumType< Tp >::type bulk_sum( Tp const * mem, int n ) {
+	return detail::bulk_sum_scalar( mem, n );
+}
+
+template< class Tp >
+inline Tp bulk_min( Tp const * mem, int n ) {
+	return detail::bulk_min_scalar( mem, n );
+}
+
+template< class Tp >
+inline Tp bulk_max( Tp const * mem, int n ) {
+	return detail::bulk_max_scalar( mem, n );
+}
+
+template< class Tp >
+inline int bulk_find( Tp const * mem, int n, Tp value ) {
+	return detail::bulk_find_scalar( mem, n, value );
+}
+
+template< class Tp >
+inline int bulk_count( Tp const * mem, int n, Tp value ) {
+	return detail::bulk_count_scalar( mem, n, value );
+}
+
+template< class Tp >
+inline void bulk_fill( Tp * mem, int n, Tp value ) {
+	detail::bulk_fill_scalar( mem, n, value );
+}
+
+template< class Tp >
+inline void bulk_add( Tp * mem, int n, Tp value ) {
+	detail::bulk_add_scalar( mem, n, value );
+}
+
+template< class Tp >
+inline void bulk_axpy( Tp * dst, Tp const * src, int n, Tp k ) {
+	detail::bulk_axpy_scalar( dst, src, n, k );
+}
+
+#ifdef BR_HAS_X86_SIMD
+#	define BR_BULK_DISPATCH( name, ... ) \
+	return simd::has_avx2() ? detail::name##_avx2( __VA_ARGS__ ) : detail::name##_sse2( __VA_ARGS__ )
+
+template<>
+inline double bulk_sum< float >( float const * mem, int n ) {
+	BR_BULK_DISPATCH( bulk_sum, mem, n );
+}
+
+template<>
+inline long long bulk_sum< int >( int const * mem, int n ) {
+	BR_BULK_DISPATCH( bulk_sum, mem, n );
+}
+
+template<>
+inline float bulk_min< float >( float const * mem, int n ) {
+	BR_BULK_DISPATCH( bulk_min, mem, n );
+}
+
+template<>
+inline int bulk_min< int >( int const * mem, int n ) {
+	BR_BULK_DISPATCH( bulk_min, mem, n );
+}
+
+template<>
+inline float bulk_max< float >( float const * mem, int n ) {
+	BR_BULK_DISPATCH( bulk_max, mem, n );
+}
+
+template<>
+inline int bulk_max< int >( int const * mem, int n ) {
+	BR_BULK_DISPATCH( bulk_max, mem, n );
+}
+
+template<>
+inline int bulk_find< float >( float const * mem, int n, float value ) {
+	BR_BULK_DISPATCH( bulk_find, mem, n, value );
+}
+
+template<>
+inline int bulk_find< int >( int const * mem, int n, int value ) {
+	BR_BULK_DISPATCH( bulk_find, mem, n, value );
+}
+
+template<>
+inline int bulk_count< float >( float const * mem, int n, float value ) {
+	BR_BULK_DISPATCH( bulk_count, mem, n, value );
+}
+
+template<>
+inline int bulk_count< int >( int const * mem, int n, int value ) {
+	BR_BULK_DISPATCH( bulk_count, mem, n, value );
+}
+
+template<>
+inline void bulk_fill< float >( float * mem, int n, float value ) {
+	BR_BULK_DISPATCH( bulk_fill, mem, n, value );
+}
+
+template<>
+inline void bulk_fill< int >( int * mem, int n, int value ) {
+	BR_BULK_DISPATCH( bulk_fill, mem, n, value );
+}
+
+template<>
+inline void bulk_add< float >( float * mem, int n, float value ) {
+	BR_BULK_DISPATCH( bulk_add, mem, n, value );
+}
+
+template<>
+inline void bulk_axpy< float >( float * dst, float const * src, int n, float k ) {
+	BR_BULK_DISPATCH( bulk_axpy, dst, src, n, k );
+}
+
+#	undef BR_BULK_DISPATCH
+#endif // BR_HAS_X86_SIMD
+
+/*
+ *  DynArrPOD 版本，作用于 [0, size()) 中的元素
+ */
+template< class Tp, int INIT, class Alloc >
+inline typename BulkSumType< Tp >::type bulk_sum( DynArrPOD< Tp, INIT, Alloc > const & arr ) {
+	return bulk_sum( arr.mem(), arr.size() );
+}
+
+template< class Tp, int INIT, class Alloc >
+inline Tp bulk_min( DynArrPOD< Tp, INIT, Alloc > const & arr ) {
+	return bulk_min( arr.mem(), arr.size() );
+}
+
+template< class Tp, int INIT, class Alloc >
+inline Tp bulk_max( DynArrPOD< Tp, INIT, Alloc > const & arr ) {
+	return bulk_max( arr.mem(), arr.size() );
+}
+
+template< class Tp, int INIT, class Alloc >
+inline int bulk_find( DynArrPOD< Tp, INIT, Alloc > const & arr, Tp value ) {
+	return bulk_find( arr.mem(), arr.size(), value );
+}
+
+template< class Tp, int INIT, class Alloc >
+inline int bulk_count( DynArrPOD< Tp, INIT, Alloc > const & arr, Tp value ) {
+	return bulk_count( arr.mem(), arr.size(), value );
+}
+
+template< class Tp, int INIT, class Alloc >
+inline void bulk_fill( DynArrPOD< Tp, INIT, Alloc > & arr, Tp value ) {
+	bulk_fill( arr.mem(), arr.size(), value );
+}
+
+}
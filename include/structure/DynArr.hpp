@@ -0,0 +1,255 @@
+﻿/*
+ * @file  include/structure/DynArr.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace BR {
+/*
+ *  @brief 可存放任意类型的动态数组
+ *
+ *  容量部分是未初始化的内存，只在 push_back/emplace_back 时构造元素。
+ *  扩容时逐个移动构造（移动构造可能抛出时退化为复制，以保证强异常安全）；
+ *  对可平凡复制的类型直接 realloc，可能原地扩展而不必复制。
+ *  内存来自 malloc/::operator new，只保证 max_align_t 的对齐。
+ */
+template< class Tp >
+class DynArr {
+public:
+	typedef Tp         value_type;
+	typedef Tp *       iterator;
+	typedef Tp const * const_iterator;
+
+	static_assert( alignof(Tp) <= alignof(std::max_align_t), "DynArr storage from malloc cannot hold over-aligned elements" );
+
+	DynArr() : m_mem( BR_NULLPTR ), m_alloc( 0 ), m_size( 0 ) {
+	}
+
+	explicit DynArr( int cap ) : m_mem( BR_NULLPTR ), m_alloc( 0 ), m_size( 0 ) {
+		reserve( cap );
+	}
+
+	DynArr( DynArr const & src ) : m_mem( BR_NULLPTR ), m_alloc( 0 ), m_size( 0 ) {
+		reserve( src.m_size );
+		try {
+			for( ; m_size<src.m_size; ++m_size ) {
+				new( m_mem + m_size ) Tp( src.m_mem[m_size] );
+			}
+		} catch( ... ) {
+			clear();
+			release( m_mem );
+			throw;
+		}
+	}
+
+	DynArr( DynArr && src ) : m_mem( src.m_mem ), m_alloc( src.m_alloc ), m_size( src.m_size ) {
+		src.m_mem = BR_NULLPTR;
+		src.m_alloc = src.m_size = 0;
+	}
+
+	~DynArr() {
+		clear();
+		release( m_mem );
+	}
+
+	DynArr & operator=( DynArr const & rhs ) {
+		if ( this != &rhs ) {
+			DynArr tmp( rhs );
+			swap( tmp );
+		}
+		return *this;
+	}
+
+	DynArr & operator=( DynArr && rhs ) {
+		if ( this != &rhs ) {
+			clear();
+			release( m_mem );
+			m_mem = rhs.m_mem;
+			m_alloc = rhs.m_alloc;
+			m_size = rhs.m_size;
+			rhs.m_mem = BR_NULLPTR;
+			rhs.m_alloc = rhs.m_size = 0;
+		}
+		return *this;
+	}
+
+	void swap( DynArr & rhs ) {
+		std::swap( m_mem, rhs.m_mem );
+		std::swap( m_alloc, rhs.m_alloc );
+		std::swap( m_size, rhs.m_size );
+	}
+
+	void push_back( Tp const & t ) {
+		emplace_back( t );
+	}
+
+	void push_back( Tp && t ) {
+		emplace_back( std::move( t ) );
+	}
+
+	template< class... Args >
+	Tp & emplace_back( Args &&... args ) {
+		if ( m_size == m_alloc ) {
+			// 参数可能引用本数组中的元素，先构造到临时对象再扩容
+			Tp tmp( std::forward< Args >( args )... );
+			grow( m_size+1 );
+			new( m_mem + m_size ) Tp( std::move( tmp ) );
+		} else {
+			new( m_mem + m_size ) Tp( std::forward< Args >( args )... );
+		}
+		return m_mem[m_size++];
+	}
+
+	void pop_back() {
+		BR_ASSERT( m_size > 0 );
+		m_mem[--m_size].~Tp();
+	}
+
+	void clear() {
+		while ( m_size > 0 ) {
+			m_mem[--m_size].~Tp();
+		}
+	}
+
+	void reserve( int cap ) {
+		if ( cap > m_alloc ) {
+			reallocate( cap );
+		}
+	}
+
+	void shrink_to_fit() {
+		if ( m_size < m_alloc ) {
+			reallocate( m_size );
+		}
+	}
+
+	bool empty() const {
+		return m_size == 0;
+	}
+
+	Tp & operator[]( int i ) {
+		BR_ASSERT( i >= 0 && i < m_size );
+		return m_mem[i];
+	}
+
+	Tp const & operator[]( int i ) const {
+		BR_ASSERT( i >= 0 && i < m_size );
+		return m_mem[i];
+	}
+
+	Tp & back() {
+		BR_ASSERT( m_size > 0 );
+		return m_mem[m_size-1];
+	}
+
+	Tp const & back() const {
+		BR_ASSERT( m_size > 0 );
+		return m_mem[m_size-1];
+	}
+
+	int size() const {
+		return m_size;
+	}
+
+	int capacity() const {
+		return m_alloc;
+	}
+
+	Tp * mem() {
+		return m_mem;
+	}
+
+	Tp const * mem() const {
+		return m_mem;
+	}
+
+	iterator begin() {
+		return m_mem;
+	}
+
+	iterator end() {
+		return m_mem + m_size;
+	}
+
+	const_iterator begin() const {
+		return m_mem;
+	}
+
+	const_iterator end() const {
+		return m_mem + m_size;
+	}
+
+private:
+	typedef std::integral_constant< bool, std::is_trivially_copyable< Tp >::value > Trivial;
+
+	void grow( int cap ) {
+		int new_alloc = m_alloc * 2;
+		reallocate( new_alloc < cap ? cap : new_alloc );
+	}
+
+	void reallocate( int new_alloc ) {
+		reallocate( new_alloc, Trivial() );
+	}
+
+	void reallocate( int new_alloc, std::true_type ) {
+		if ( new_alloc == 0 ) {
+			release( m_mem );
+			m_mem = BR_NULLPTR;
+		} else {
+			Tp * new_mem = (Tp *)std::realloc( m_mem, sizeof(Tp)*new_alloc );
+			if ( new_mem == BR_NULLPTR ) {
+				throw std::bad_alloc();
+			}
+			m_mem = new_mem;
+		}
+		m_alloc = new_alloc;
+	}
+
+	void reallocate( int new_alloc, std::false_type ) {
+		Tp * new_mem = new_alloc ? (Tp *)::operator new( sizeof(Tp)*new_alloc ) : BR_NULLPTR;
+		int i = 0;
+		try {
+			for( ; i<m_size; ++i ) {
+				new( new_mem + i ) Tp( std::move_if_noexcept( m_mem[i] ) );
+			}
+		} catch( ... ) {
+			while ( i > 0 ) {
+				new_mem[--i].~Tp();
+			}
+			::operator delete( new_mem );
+			throw;
+		}
+		for( i=0; i<m_size; ++i ) {
+			m_mem[i].~Tp();
+		}
+		release( m_mem );
+		m_mem = new_mem;
+		m_alloc = new_alloc;
+	}
+
+	static void release( Tp * mem ) {
+		release( mem, Trivial() );
+	}
+
+	static void release( Tp * mem, std::true_type ) {
+		std::free( mem );
+	}
+
+	static void release( Tp * mem, std::false_type ) {
+		::operator delete( mem );
+	}
+
+	Tp  * m_mem;
+	int   m_alloc;  // objects allocated
+	int   m_size;   // number objects in use
+};
+
+}
@@ -5,20 +5,67 @@
 
 #include <config.hpp>
 
+#include <climits>
+#include <cstring>
+
+#include <memory/RawAlloc.hpp>
+
 namespace BR {
 /*
  *  @brief 专用于存放POD类型变量的动态数组
+ *  @param  INIT   内联容量，元素不超过 INIT 个时不分配堆内存
+ *  @param  Alloc  超出内联容量后使用的原始内存分配器，见 memory/RawAlloc.hpp；可换成 ArenaRawAlloc
  */
-template< class Tp, int INIT >
+template< class Tp, int INIT, class Alloc = HeapRawAlloc >
 class DynArrPOD {
 public:
 	typedef Tp value_type;
 
-	DynArrPODPOD() : m_mem(new Tp[INIT]), m_alloc(INIT), m_size(0) {
+	static_assert( INIT > 0, "inline capacity must be positive" );
+
+	DynArrPOD() : m_raw(), m_mem( m_inline ), m_alloc(INIT), m_size(0), m_growth(2.0f) {
+	}
+
+	explicit DynArrPOD( Alloc const & raw ) : m_raw( raw ), m_mem( m_inline ), m_alloc(INIT), m_size(0), m_growth(2.0f) {
 	}
 
-	~DynArrPODPOD() {
-		delete [] m_mem;
+	/*
+	 *  复制时元素不超过 INIT 个就放在副本自己的内联缓冲区中
+	 */
+	DynArrPOD( DynArrPOD const & src ) :
+		m_raw( src.m_raw ), m_mem( m_inline ), m_alloc(INIT), m_size(0), m_growth( src.m_growth ) {
+		assign( src );
+	}
+
+	/*
+	 *  移动时接管堆上的缓冲区，内联的元素逐字节复制；src 变为空的内联数组
+	 */
+	DynArrPOD( DynArrPOD && src ) :
+		m_raw( src.m_raw ), m_mem( m_inline ), m_alloc(INIT), m_size(0), m_growth( src.m_growth ) {
+		take( src );
+	}
+
+	~DynArrPOD() {
+		release();
+	}
+
+	DynArrPOD & operator=( DynArrPOD const & rhs ) {
+		if ( this != &rhs ) {
+			assign( rhs );
+		}
+		return *this;
+	}
+
+	DynArrPOD & operator=( DynArrPOD && rhs ) {
+		if ( this != &rhs ) {
+			release();
+			m_raw = rhs.m_raw;
+			m_mem = m_inline;
+			m_alloc = INIT;
+			m_size = 0;
+			take( rhs );
+		}
+		return *this;
 	}
 
 	void push_back( Tp t ) {
@@ -27,10 +74,46 @@ public:
 	}
 
 	Tp pop_back() {
-		BR_ASSERT( i > 0 );
+		BR_ASSERT( m_size > 0 );
 		return m_mem[--m_size];
 	}
 
+	void reserve( int cap ) {
+		if ( cap > m_alloc ) {
+			reallocate( cap );
+		}
+	}
+
+	void clear() {
+		m_size = 0;
+	}
+
+	/*
+	 *  释放多余的容量，元素不超过 INIT 个时回到内联缓冲区
+	 */
+	void shrink_to_fit() {
+		if ( m_mem == m_inline ) {
+			return;
+		}
+		if ( m_size <= INIT ) {
+			memcpy( m_inline, m_mem, sizeof(Tp)*m_size );
+			release();
+			m_mem = m_inline;
+			m_alloc = INIT;
+		} else if ( m_size < m_alloc ) {
+			m_mem = (Tp *)m_raw.reallocate( m_mem, sizeof(Tp)*m_alloc, sizeof(Tp)*m_size, sizeof(Tp)*m_size );
+			m_alloc = m_size;
+		}
+	}
+
+	/*
+	 *  扩容时容量至少乘以 factor，默认为 2
+	 */
+	void set_growth_factor( float factor ) {
+		BR_ASSERT( factor > 1.0f );
+		m_growth = factor;
+	}
+
 	bool empty() const {
 		return m_size == 0;
 	}
@@ -61,22 +144,72 @@ public:
 		return m_mem;
 	}
 
+	/*
+	 *  元素是否仍在内联缓冲区中
+	 */
+	bool is_inline() const {
+		return m_mem == m_inline;
+	}
+
 private:
+	void assign( DynArrPOD const & src ) {
+		m_size = 0;
+		reserve( src.m_size );
+		memcpy( m_mem, src.m_mem, sizeof(Tp)*src.m_size );
+		m_size = src.m_size;
+	}
+
+	void take( DynArrPOD & src ) {
+		if ( src.m_mem == src.m_inline ) {
+			memcpy( m_inline, src.m_inline, sizeof(Tp)*src.m_size );
+		} else {
+			m_mem = src.m_mem;
+			m_alloc = src.m_alloc;
+			src.m_mem = src.m_inline;
+			src.m_alloc = INIT;
+		}
+		m_size = src.m_size;
+		src.m_size = 0;
+	}
+
+	Tp * allocate( int n ) {
+		return (Tp *)m_raw.allocate( sizeof(Tp)*n );
+	}
+
+	void release() {
+		if ( m_mem != m_inline ) {
+			m_raw.deallocate( m_mem, sizeof(Tp)*m_alloc );
+		}
+	}
+
 	void ensure_capacity( int cap ) {
 		if ( cap > m_alloc ) {
-			int new_alloc = cap * 2;
-			Tp * new_mem = new Tp[new_alloc];
-			// @WARNING not using constructors, only works for PODs
-			memcpy( new_mem, m_mem, sizeof(Tp)*m_size );
-			delete [] m_mem;
-			m_mem = new_mem;
-			m_alloc = new_alloc;
+			// 在 double 中按增长因子放大，容量以 int 表示，不超过 INT_MAX
+			double grown = (double)m_alloc * m_growth;
+			int new_alloc = grown < (double)INT_MAX ? (int)grown : INT_MAX;
+			reallocate( new_alloc > cap ? new_alloc : cap );
         }
     }
 
+	void reallocate( int new_alloc ) {
+		// @WARNING not using constructors, only works for PODs
+		if ( m_mem == m_inline ) {
+			Tp * new_mem = allocate( new_alloc );
+			memcpy( new_mem, m_mem, sizeof(Tp)*m_size );
+			m_mem = new_mem;
+		} else {
+			// 交给分配器原地扩展或重新映射，避免同时持有新旧两份缓冲区
+			m_mem = (Tp *)m_raw.reallocate( m_mem, sizeof(Tp)*m_alloc, sizeof(Tp)*new_alloc, sizeof(Tp)*m_size );
+		}
+		m_alloc = new_alloc;
+	}
+
+	Alloc   m_raw;
 	Tp  * m_mem;
+	Tp    m_inline[INIT];
     int   m_alloc;  // objects allocated
     int   m_size;   // number objects in use
+	float m_growth;
 };
 
 }
\ No newline at end of file
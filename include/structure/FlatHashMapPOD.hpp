@@ -0,0 +1,424 @@
+﻿/*
+ * @file  include/structure/FlatHashMapPOD.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include HEADER_STDINT
+
+#include <memory/RawAlloc.hpp>
+#include <simd/CpuFeatures.hpp>
+
+namespace BR {
+/*
+ *  @brief 按字节计算 POD 键的哈希值
+ *
+ *  不超过 8 字节的键（整数、XYPair<int> 等）读成一个 64 位整数后混合；
+ *  更长的键每 8 字节混合一次。键中不能含有未初始化的填充字节。
+ */
+template< class Key >
+struct PODHash {
+	std::size_t operator()( Key const & key ) const {
+		unsigned char const * bytes = (unsigned char const *)&key;
+		std::uint64_t h = sizeof(Key);
+		std::size_t i = 0;
+		for( ; i + 8 <= sizeof(Key); i += 8 ) {
+			std::uint64_t word;
+			memcpy( &word, bytes + i, 8 );
+			h = mix( h ^ word );
+		}
+		if ( i < sizeof(Key) ) {
+			std::uint64_t word = 0;
+			memcpy( &word, bytes + i, sizeof(Key) - i );
+			h = mix( h ^ word );
+		}
+		return (std::size_t)h;
+	}
+
+private:
+	static std::uint64_t mix( std::uint64_t x ) {
+		// splitmix64 的终结函数
+		x = ( x ^ ( x >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+		x = ( x ^ ( x >> 27 ) ) * 0x94d049bb133111ebULL;
+		return x ^ ( x >> 31 );
+	}
+};
+
+/*
+ *  @brief 按字节比较 POD 键，与 PODHash 保持一致
+ */
+template< class Key >
+struct PODEqual {
+	bool operator()( Key const & lhs, Key const & rhs ) const {
+		return memcmp( &lhs, &rhs, sizeof(Key) ) == 0;
+	}
+};
+
+namespace detail {
+
+/*
+ *  一组 16 个控制字节：EMPTY/DELETED 的最高位为 1，已占用的槽位存放哈希值的低 7 位
+ */
+struct HashGroup {
+	static int const WIDTH = 16;
+
+	static signed char const EMPTY   = -128;
+	static signed char const DELETED = -2;
+
+	explicit HashGroup( signed char const * ctrl ) : m_ctrl() {
+#ifdef BR_HAS_X86_SIMD
+		m_ctrl = _mm_loadu_si128( (__m128i const *)ctrl );
+#else
+		memcpy( m_ctrl, ctrl, WIDTH );
+#endif // BR_HAS_X86_SIMD
+	}
+
+	/*
+	 *  控制字节等于 h2 的位置构成的位掩码
+	 */
+	unsigned match( signed char h2 ) const {
+#ifdef BR_HAS_X86_SIMD
+		return (unsigned)_mm_movemask_epi8( _mm_cmpeq_epi8( m_ctrl, _mm_set1_epi8( h2 ) ) );
+#else
+		unsigned mask = 0;
+		for( int i=0; i<WIDTH; ++i ) {
+			mask |= unsigned( m_ctrl[i] == h2 ) << i;
+		}
+		return mask;
+#endif // BR_HAS_X86_SIMD
+	}
+
+	unsigned match_empty() const {
+		return match( EMPTY );
+	}
+
+	/*
+	 *  EMPTY 或 DELETED，即最高位为 1 的位置
+	 */
+	unsigned match_free() const {
+#ifdef BR_HAS_X86_SIMD
+		return (unsigned)_mm_movemask_epi8( m_ctrl );
+#else
+		unsigned mask = 0;
+		for( int i=0; i<WIDTH; ++i ) {
+			mask |= unsigned( m_ctrl[i] < 0 ) << i;
+		}
+		return mask;
+#endif // BR_HAS_X86_SIMD
+	}
+
+private:
+#ifdef BR_HAS_X86_SIMD
+	__m128i     m_ctrl;
+#else
+	signed char m_ctrl[WIDTH];
+#endif // BR_HAS_X86_SIMD
+};
+
+inline int lowest_bit( unsigned mask ) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctz( mask );
+#else
+	int i = 0;
+	while ( ( mask & 1u ) == 0 ) {
+		mask >>= 1;
+		++i;
+	}
+	return i;
+#endif
+}
+
+} // namespace detail
+
+/*
+ *  @brief 开放寻址、槽位连续存放的哈希表，只存放可平凡复制的键与值
+ *  @param  Hash   哈希函数，默认按字节计算
+ *  @param  Equal  键比较，默认按字节比较
+ *  @param  Alloc  原始内存分配器，见 memory/RawAlloc.hpp
+ *
+ *  布局同 SwissTable：每个槽位对应一个控制字节，控制字节与槽位数组放在同一块内存中，
+ *  查找时一次比较 16 个控制字节（SSE2），只对 7 位哈希相同的槽位比较键，
+ *  不需要像 std::unordered_map 那样沿链表跳转。
+ *  控制字节数组末尾复制了前 16 个字节，因此任意位置起的一组都可以直接读取。
+ *  按组做二次探测；删除留下墓碑，墓碑过多时原容量重建。装载因子上限 7/8。
+ *  插入可能重建表，之后之前返回的指针失效。
+ */
+template< class Key, class Val, class Hash = PODHash< Key >, class Equal = PODEqual< Key >, class Alloc = HeapRawAlloc >
+class FlatHashMapPOD {
+public:
+	typedef Key key_type;
+	typedef Val mapped_type;
+
+	static_assert( std::is_trivially_copyable< Key >::value, "FlatHashMapPOD keys must be trivially copyable" );
+	static_assert( std::is_trivially_copyable< Val >::value, "FlatHashMapPOD values must be trivially copyable" );
+
+	struct Slot {
+		Key key;
+		Val val;
+	};
+
+	FlatHashMapPOD() : m_raw(), m_hash(), m_equal(), m_ctrl( BR_NULLPTR ), m_slots( BR_NULLPTR ), m_capacity( 0 ), m_size( 0 ), m_growth_left( 0 ) {
+	}
+
+	explicit FlatHashMapPOD( Alloc const & raw ) : m_raw( raw ), m_hash(), m_equal(), m_ctrl( BR_NULLPTR ), m_slots( BR_NULLPTR ), m_capacity( 0 ), m_size( 0 ), m_growth_left( 0 ) {
+	}
+
+	~FlatHashMapPOD() {
+		release();
+	}
+
+	/*
+	 *  键不存在时返回 BR_NULLPTR
+	 */
+	Val * find( Key const & key ) {
+		int i = find_index( key );
+		return i < 0 ? BR_NULLPTR : &m_slots[i].val;
+	}
+
+	Val const * find( Key const & key ) const {
+		int i = find_index( key );
+		return i < 0 ? BR_NULLPTR : &m_slots[i].val;
+	}
+
+	bool contains( Key const & key ) const {
+		return find_index( key ) >= 0;
+	}
+
+	/*
+	 *  键已存在时不覆盖，返回 false
+	 */
+	bool insert( Key const & key, Val const & val ) {
+		std::size_t h = m_hash( key );
+		if ( find_index( key, h ) >= 0 ) {
+			return false;
+		}
+		int i = prepare_insert( h );
+		m_slots[i].key = key;
+		m_slots[i].val = val;
+		return true;
+	}
+
+	/*
+	 *  键不存在时插入 Val()
+	 */
+	Val & operator[]( Key const & key ) {
+		std::size_t h = m_hash( key );
+		int i = find_index( key, h );
+		if ( i < 0 ) {
+			i = prepare_insert( h );
+			m_slots[i].key = key;
+			m_slots[i].val = Val();
+		}
+		return m_slots[i].val;
+	}
+
+	bool erase( Key const & key ) {
+		int i = find_index( key );
+		if ( i < 0 ) {
+			return false;
+		}
+		set_ctrl( i, detail::HashGroup::DELETED );
+		--m_size;
+		return true;
+	}
+
+	void clear() {
+		if ( m_capacity != 0 ) {
+			reset_ctrl();
+		}
+		m_size = 0;
+		m_growth_left = max_load( m_capacity );
+	}
+
+	/*
+	 *  保证插入 n 个键之前不会重建
+	 */
+	void reserve( int n ) {
+		if ( n > max_load( m_capacity ) ) {
+			int cap = detail::HashGroup::WIDTH;
+			while ( max_load( cap ) < n ) {
+				cap *= 2;
+			}
+			rehash( cap );
+		}
+	}
+
+	/*
+	 *  依次对每个元素调用 fn( key, val )，顺序不确定
+	 */
+	template< class Fn >
+	void for_each( Fn fn ) {
+		for( int i=0; i<m_capacity; ++i ) {
+			if ( m_ctrl[i] >= 0 ) {
+				fn( m_slots[i].key, m_slots[i].val );
+			}
+		}
+	}
+
+	template< class Fn >
+	void for_each( Fn fn ) const {
+		for( int i=0; i<m_capacity; ++i ) {
+			if ( m_ctrl[i] >= 0 ) {
+				fn( m_slots[i].key, m_slots[i].val );
+			}
+		}
+	}
+
+	bool empty() const {
+		return m_size == 0;
+	}
+
+	int size() const {
+		return m_size;
+	}
+
+	int capacity() const {
+		return m_capacity;
+	}
+
+private:
+	FlatHashMapPOD( FlatHashMapPOD const & );
+	FlatHashMapPOD & operator=( FlatHashMapPOD const & );
+
+	static int max_load( int cap ) {
+		return cap - cap / 8;
+	}
+
+	static signed char h2( std::size_t h ) {
+		return (signed char)( h & 0x7F );
+	}
+
+	static std::size_t h1( std::size_t h ) {
+		return h >> 7;
+	}
+
+	int find_index( Key const & key ) const {
+		return find_index( key, m_hash( key ) );
+	}
+
+	int find_index( Key const & key, std::size_t h ) const {
+		if ( m_capacity == 0 ) {
+			return -1;
+		}
+		std::size_t mask = m_capacity - 1;
+		std::size_t pos = h1( h ) & mask;
+		std::size_t step = 0;
+		signed char tag = h2( h );
+		for( ;; ) {
+			detail::HashGroup group( m_ctrl + pos );
+			for( unsigned bits = group.match( tag ); bits != 0; bits &= bits - 1 ) {
+				std::size_t i = ( pos + detail::lowest_bit( bits ) ) & mask;
+				if ( m_equal( m_slots[i].key, key ) ) {
+					return (int)i;
+				}
+			}
+			if ( group.match_empty() != 0 ) {
+				return -1;
+			}
+			step += detail::HashGroup::WIDTH;
+			pos = ( pos + step ) & mask;
+		}
+	}
+
+	/*
+	 *  沿探测序列找到第一个空槽或墓碑
+	 */
+	int find_free( std::size_t h ) const {
+		std::size_t mask = m_capacity - 1;
+		std::size_t pos = h1( h ) & mask;
+		std::size_t step = 0;
+		for( ;; ) {
+			unsigned bits = detail::HashGroup( m_ctrl + pos ).match_free();
+			if ( bits != 0 ) {
+				return (int)( ( pos + detail::lowest_bit( bits ) ) & mask );
+			}
+			step += detail::HashGroup::WIDTH;
+			pos = ( pos + step ) & mask;
+		}
+	}
+
+	int prepare_insert( std::size_t h ) {
+		int i = m_capacity == 0 ? -1 : find_free( h );
+		// 复用墓碑不消耗余量；余量必须保证表中始终有空槽，探测才能终止
+		if ( i < 0 || ( m_growth_left == 0 && m_ctrl[i] == detail::HashGroup::EMPTY ) ) {
+			if ( m_capacity != 0 && m_size < max_load( m_capacity ) / 2 ) {
+				rehash( m_capacity );
+			} else {
+				rehash( m_capacity == 0 ? detail::HashGroup::WIDTH : m_capacity * 2 );
+			}
+			i = find_free( h );
+		}
+		if ( m_ctrl[i] == detail::HashGroup::EMPTY ) {
+			--m_growth_left;
+		}
+		set_ctrl( i, h2( h ) );
+		++m_size;
+		return i;
+	}
+
+	void set_ctrl( int i, signed char c ) {
+		m_ctrl[i] = c;
+		if ( i < detail::HashGroup::WIDTH ) {
+			m_ctrl[m_capacity + i] = c;
+		}
+	}
+
+	void reset_ctrl() {
+		memset( m_ctrl, (unsigned char)detail::HashGroup::EMPTY, m_capacity + detail::HashGroup::WIDTH );
+	}
+
+	static std::size_t ctrl_bytes( int cap ) {
+		// 槽位数组从 16 字节边界开始
+		return ( cap + detail::HashGroup::WIDTH + 15 ) & ~std::size_t( 15 );
+	}
+
+	static std::size_t total_bytes( int cap ) {
+		return ctrl_bytes( cap ) + sizeof(Slot) * cap;
+	}
+
+	void rehash( int new_cap ) {
+		signed char * old_ctrl = m_ctrl;
+		Slot * old_slots = m_slots;
+		int old_cap = m_capacity;
+
+		char * mem = (char *)m_raw.allocate( total_bytes( new_cap ) );
+		m_ctrl = (signed char *)mem;
+		m_slots = (Slot *)( mem + ctrl_bytes( new_cap ) );
+		m_capacity = new_cap;
+		reset_ctrl();
+		for( int i=0; i<old_cap; ++i ) {
+			if ( old_ctrl[i] >= 0 ) {
+				std::size_t h = m_hash( old_slots[i].key );
+				int j = find_free( h );
+				set_ctrl( j, h2( h ) );
+				m_slots[j] = old_slots[i];
+			}
+		}
+		m_growth_left = max_load( new_cap ) - m_size;
+		if ( old_ctrl != BR_NULLPTR ) {
+			m_raw.deallocate( old_ctrl, total_bytes( old_cap ) );
+		}
+	}
+
+	void release() {
+		if ( m_ctrl != BR_NULLPTR ) {
+			m_raw.deallocate( m_ctrl, total_bytes( m_capacity ) );
+		}
+	}
+
+	Alloc         m_raw;
+	Hash          m_hash;
+	Equal         m_equal;
+	signed char * m_ctrl;         // m_capacity + 16 个控制字节
+	Slot        * m_slots;
+	int           m_capacity;     // 槽位数，0 或不小于 16 的 2 的幂
+	int           m_size;
+	int           m_growth_left;  // 还能占用多少个空槽而不重建
+};
+
+}
@@ -0,0 +1,264 @@
+﻿/*
+ * @file  include/structure/MappedArrPOD.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include HEADER_STDINT
+
+#ifdef BR_HAS_MMAP
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif // BR_HAS_MMAP
+
+namespace BR {
+#ifdef BR_HAS_MMAP
+/*
+ *  @brief 映射文件的文件头，元素紧随其后
+ */
+struct MappedArrHeader {
+	char          magic[8];   // "BRMAPARR"
+	std::uint32_t format;     // 文件格式版本，见 MappedArrHeader::FORMAT
+	std::uint32_t version;    // 使用者给出的数据版本
+	std::uint32_t elem_size;  // sizeof(Tp)
+	std::uint32_t elem_align; // alignof(Tp)
+	std::uint64_t size;       // 元素个数
+	std::uint64_t capacity;   // 文件可容纳的元素个数
+
+	BR_STATIC_CONSTEXPR std::uint32_t FORMAT = 1;
+	BR_STATIC_CONSTEXPR std::size_t   DATA_OFFSET = 64;   // 元素起始偏移，保证对齐
+};
+
+/*
+ *  @brief 存放在映射文件中的 POD 动态数组，接口同 DynArrPOD
+ *  @param  INIT   新建文件时的初始容量
+ *
+ *  打开已有文件只需映射并校验文件头，不必逐个读回元素；size 记在映射的文件头中，
+ *  push_back 后无需额外保存。扩容时先 ftruncate 文件再重新映射（Linux 上用 mremap），
+ *  扩容后原有的指针与引用失效。
+ *  文件头中的元素大小、对齐或版本与当前程序不符时抛出 std::runtime_error。
+ *  文件按本机字节序存放，不能在字节序不同的机器间共享。
+ */
+template< class Tp, int INIT = 1024 >
+class MappedArrPOD {
+public:
+	typedef Tp value_type;
+
+	static_assert( INIT > 0, "initial capacity must be positive" );
+	static_assert( std::is_pod< Tp >::value, "MappedArrPOD only holds POD types" );
+	static_assert( std::alignment_of< Tp >::value <= MappedArrHeader::DATA_OFFSET, "element alignment exceeds the data offset" );
+
+	/*
+	 *  打开 path，不存在或为空时新建
+	 *  @param  version  数据版本，与文件中记录的不同时抛出异常
+	 */
+	explicit MappedArrPOD( char const * path, std::uint32_t version = 0 ) : m_fd( -1 ), m_map( BR_NULLPTR ), m_bytes( 0 ) {
+		m_fd = ::open( path, O_RDWR | O_CREAT, 0644 );
+		if ( m_fd < 0 ) {
+			throw std::runtime_error( std::string( "MappedArrPOD: cannot open " ) + path );
+		}
+		try {
+			struct stat st;
+			if ( ::fstat( m_fd, &st ) != 0 ) {
+				fail( "fstat" );
+			}
+			if ( st.st_size == 0 ) {
+				create( version );
+			} else {
+				attach( (std::size_t)st.st_size, version );
+			}
+		} catch( ... ) {
+			close();
+			throw;
+		}
+	}
+
+	~MappedArrPOD() {
+		close();
+	}
+
+	void push_back( Tp t ) {
+		ensure_capacity( size()+1 );
+		mem()[header()->size++] = t;
+	}
+
+	Tp pop_back() {
+		BR_ASSERT( size() > 0 );
+		return mem()[--header()->size];
+	}
+
+	void clear() {
+		header()->size = 0;
+	}
+
+	void reserve( int cap ) {
+		if ( cap > capacity() ) {
+			remap( cap );
+		}
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	Tp & operator[](int i) {
+		BR_ASSERT( i >= 0 && i < size() );
+		return mem()[i];
+	}
+
+	Tp const & operator[](int i) const {
+		BR_ASSERT( i >= 0 && i < size() );
+		return mem()[i];
+	}
+
+	int size() const {
+		return (int)header()->size;
+	}
+
+	int capacity() const {
+		return (int)header()->capacity;
+	}
+
+	Tp * mem() {
+		return (Tp *)( (char *)m_map + MappedArrHeader::DATA_OFFSET );
+	}
+
+	Tp const * mem() const {
+		return (Tp const *)( (char const *)m_map + MappedArrHeader::DATA_OFFSET );
+	}
+
+	std::uint32_t version() const {
+		return header()->version;
+	}
+
+	/*
+	 *  把修改同步写回磁盘；不调用时由内核择机写回，进程崩溃也不会丢失，但掉电可能丢失
+	 */
+	void sync() {
+		if ( ::msync( m_map, m_bytes, MS_SYNC ) != 0 ) {
+			fail( "msync" );
+		}
+	}
+
+private:
+	MappedArrPOD( MappedArrPOD const & );
+	MappedArrPOD & operator=( MappedArrPOD const & );
+
+	MappedArrHeader * header() {
+		return (MappedArrHeader *)m_map;
+	}
+
+	MappedArrHeader const * header() const {
+		return (MappedArrHeader const *)m_map;
+	}
+
+	static std::size_t bytes_for( std::uint64_t cap ) {
+		return MappedArrHeader::DATA_OFFSET + sizeof(Tp)*(std::size_t)cap;
+	}
+
+	void fail( char const * what ) {
+		throw std::runtime_error( std::string( "MappedArrPOD: " ) + what + " failed" );
+	}
+
+	void map( std::size_t bytes ) {
+		void * mem = ::mmap( BR_NULLPTR, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0 );
+		if ( mem == MAP_FAILED ) {
+			fail( "mmap" );
+		}
+		m_map = mem;
+		m_bytes = bytes;
+	}
+
+	void create( std::uint32_t version ) {
+		std::size_t bytes = bytes_for( INIT );
+		if ( ::ftruncate( m_fd, (off_t)bytes ) != 0 ) {
+			fail( "ftruncate" );
+		}
+		map( bytes );
+		MappedArrHeader * h = header();
+		memcpy( h->magic, "BRMAPARR", sizeof(h->magic) );
+		h->format = MappedArrHeader::FORMAT;
+		h->version = version;
+		h->elem_size = sizeof(Tp);
+		h->elem_align = std::alignment_of< Tp >::value;
+		h->size = 0;
+		h->capacity = INIT;
+	}
+
+	void attach( std::size_t file_bytes, std::uint32_t version ) {
+		if ( file_bytes < MappedArrHeader::DATA_OFFSET ) {
+			throw std::runtime_error( "MappedArrPOD: file too small for header" );
+		}
+		map( file_bytes );
+		MappedArrHeader const * h = header();
+		if ( memcmp( h->magic, "BRMAPARR", sizeof(h->magic) ) != 0 || h->format != MappedArrHeader::FORMAT ) {
+			throw std::runtime_error( "MappedArrPOD: not a MappedArrPOD file" );
+		}
+		if ( h->elem_size != sizeof(Tp) || h->elem_align != std::alignment_of< Tp >::value ) {
+			throw std::runtime_error( "MappedArrPOD: element layout mismatch" );
+		}
+		if ( h->version != version ) {
+			throw std::runtime_error( "MappedArrPOD: version mismatch" );
+		}
+		if ( h->size > h->capacity || bytes_for( h->capacity ) > file_bytes ) {
+			throw std::runtime_error( "MappedArrPOD: corrupt header" );
+		}
+	}
+
+	void ensure_capacity( int cap ) {
+		if ( cap > capacity() ) {
+			// 在 size_t 中翻倍，容量以 int 表示，不超过 INT_MAX
+			std::size_t doubled = (std::size_t)capacity() * 2;
+			int new_cap = doubled < (std::size_t)INT_MAX ? (int)doubled : INT_MAX;
+			remap( new_cap > cap ? new_cap : cap );
+		}
+	}
+
+	void remap( int new_cap ) {
+		std::size_t new_bytes = bytes_for( new_cap );
+		if ( ::ftruncate( m_fd, (off_t)new_bytes ) != 0 ) {
+			fail( "ftruncate" );
+		}
+#ifdef BR_HAS_MREMAP
+		void * mem = ::mremap( m_map, m_bytes, new_bytes, MREMAP_MAYMOVE );
+		if ( mem == MAP_FAILED ) {
+			fail( "mremap" );
+		}
+		m_map = mem;
+		m_bytes = new_bytes;
+#else
+		::munmap( m_map, m_bytes );
+		m_map = BR_NULLPTR;
+		map( new_bytes );
+#endif // BR_HAS_MREMAP
+		header()->capacity = new_cap;
+	}
+
+	void close() {
+		if ( m_map != BR_NULLPTR ) {
+			::munmap( m_map, m_bytes );
+			m_map = BR_NULLPTR;
+		}
+		if ( m_fd >= 0 ) {
+			::close( m_fd );
+			m_fd = -1;
+		}
+	}
+
+	int         m_fd;
+	void      * m_map;    // 文件头与元素的映射
+	std::size_t m_bytes;  // 映射的字节数，即文件长度
+};
+#endif // BR_HAS_MMAP
+
+}
@@ -0,0 +1,269 @@
+﻿/*
+ * @file  include/structure/RingPOD.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace BR {
+/*
+ *  @brief 单生产者单消费者的无锁有界环形队列，只存放 POD 类型
+ *  @param  CAPACITY  容量，须为 2 的幂
+ *
+ *  m_tail 只由生产者写，m_head 只由消费者写，两者各占一条缓存行；
+ *  双方各缓存一份对方的下标，只在看起来满或空时才重新读取，减少缓存行来回传递。
+ *  下标单调递增，取模后定位槽位，因此满与空不需要额外的空槽区分。
+ *  push_n/pop_n 一次发布一整批，至多两次 memcpy。
+ */
+template< class Tp, int CAPACITY >
+class SpscRingPOD {
+public:
+	typedef Tp value_type;
+
+	static_assert( CAPACITY > 0 && ( CAPACITY & ( CAPACITY - 1 ) ) == 0, "CAPACITY must be a power of 2" );
+	static_assert( std::is_pod< Tp >::value, "SpscRingPOD only holds POD types" );
+
+	SpscRingPOD() : m_head( 0 ), m_tail_cache( 0 ), m_tail( 0 ), m_head_cache( 0 ) {
+	}
+
+	/*
+	 *  仅限生产者线程调用，队列满时返回 false
+	 */
+	bool try_push( Tp const & t ) {
+		std::size_t tail = m_tail.load( std::memory_order_relaxed );
+		if ( tail - m_head_cache == CAPACITY ) {
+			m_head_cache = m_head.load( std::memory_order_acquire );
+			if ( tail - m_head_cache == CAPACITY ) {
+				return false;
+			}
+		}
+		m_buf[tail & MASK] = t;
+		m_tail.store( tail + 1, std::memory_order_release );
+		return true;
+	}
+
+	/*
+	 *  仅限生产者线程调用，尽量压入 n 个元素，返回实际压入的个数
+	 */
+	int push_n( Tp const * in, int n ) {
+		std::size_t tail = m_tail.load( std::memory_order_relaxed );
+		std::size_t room = CAPACITY - ( tail - m_head_cache );
+		if ( room < (std::size_t)n ) {
+			m_head_cache = m_head.load( std::memory_order_acquire );
+			room = CAPACITY - ( tail - m_head_cache );
+		}
+		if ( room > (std::size_t)n ) {
+			room = n;
+		}
+		copy_in( tail, in, room );
+		m_tail.store( tail + room, std::memory_order_release );
+		return (int)room;
+	}
+
+	/*
+	 *  仅限消费者线程调用，队列空时返回 false
+	 */
+	bool try_pop( Tp & t ) {
+		std::size_t head = m_head.load( std::memory_order_relaxed );
+		if ( head == m_tail_cache ) {
+			m_tail_cache = m_tail.load( std::memory_order_acquire );
+			if ( head == m_tail_cache ) {
+				return false;
+			}
+		}
+		t = m_buf[head & MASK];
+		m_head.store( head + 1, std::memory_order_release );
+		return true;
+	}
+
+	/*
+	 *  仅限消费者线程调用，至多弹出 n 个元素，返回实际弹出的个数
+	 */
+	int pop_n( Tp * out, int n ) {
+		std::size_t head = m_head.load( std::memory_order_relaxed );
+		std::size_t avail = m_tail_cache - head;
+		if ( avail < (std::size_t)n ) {
+			m_tail_cache = m_tail.load( std::memory_order_acquire );
+			avail = m_tail_cache - head;
+		}
+		if ( avail > (std::size_t)n ) {
+			avail = n;
+		}
+		copy_out( head, out, avail );
+		m_head.store( head + avail, std::memory_order_release );
+		return (int)avail;
+	}
+
+	/*
+	 *  并发时只是近似值
+	 */
+	int size() const {
+		return (int)( m_tail.load( std::memory_order_acquire ) - m_head.load( std::memory_order_acquire ) );
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	static int capacity() {
+		return CAPACITY;
+	}
+
+private:
+	SpscRingPOD( SpscRingPOD const & );
+	SpscRingPOD & operator=( SpscRingPOD const & );
+
+	static std::size_t const MASK = CAPACITY - 1;
+
+	void copy_in( std::size_t pos, Tp const * in, std::size_t n ) {
+		std::size_t i = pos & MASK;
+		std::size_t first = n < CAPACITY - i ? n : CAPACITY - i;
+		memcpy( m_buf + i, in, sizeof(Tp)*first );
+		memcpy( m_buf, in + first, sizeof(Tp)*( n - first ) );
+	}
+
+	void copy_out( std::size_t pos, Tp * out, std::size_t n ) const {
+		std::size_t i = pos & MASK;
+		std::size_t first = n < CAPACITY - i ? n : CAPACITY - i;
+		memcpy( out, m_buf + i, sizeof(Tp)*first );
+		memcpy( out + first, m_buf, sizeof(Tp)*( n - first ) );
+	}
+
+	char                       m_pad0[BR_CACHE_LINE_SIZE];
+	// 消费者的缓存行
+	std::atomic< std::size_t > m_head;
+	std::size_t                m_tail_cache;
+	char                       m_pad1[BR_CACHE_LINE_SIZE];
+	// 生产者的缓存行
+	std::atomic< std::size_t > m_tail;
+	std::size_t                m_head_cache;
+	char                       m_pad2[BR_CACHE_LINE_SIZE];
+	Tp                         m_buf[CAPACITY];
+};
+
+/*
+ *  @brief 多生产者多消费者的无锁有界环形队列，只存放 POD 类型
+ *  @param  CAPACITY  容量，须为 2 的幂
+ *
+ *  每个槽位带一个序号（Vyukov 有界队列）：序号等于下标时槽位可写，等于下标 + 1 时可读。
+ *  生产者与消费者分别用 CAS 抢占 m_enqueue 与 m_dequeue，两者各占一条缓存行；
+ *  抢到下标后只访问自己的槽位，写完再发布序号。
+ *  某个线程在抢到下标后被挂起时，后续同一槽位上的操作会暂时看到队列满或空。
+ */
+template< class Tp, int CAPACITY >
+class MpmcRingPOD {
+public:
+	typedef Tp value_type;
+
+	static_assert( CAPACITY > 1 && ( CAPACITY & ( CAPACITY - 1 ) ) == 0, "CAPACITY must be a power of 2 and at least 2" );
+	static_assert( std::is_pod< Tp >::value, "MpmcRingPOD only holds POD types" );
+
+	MpmcRingPOD() : m_enqueue( 0 ), m_dequeue( 0 ) {
+		for( int i=0; i<CAPACITY; ++i ) {
+			m_cells[i].seq.store( i, std::memory_order_relaxed );
+		}
+	}
+
+	bool try_push( Tp const & t ) {
+		std::size_t pos = m_enqueue.load( std::memory_order_relaxed );
+		for( ;; ) {
+			Cell & cell = m_cells[pos & MASK];
+			std::size_t seq = cell.seq.load( std::memory_order_acquire );
+			std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+			if ( diff == 0 ) {
+				if ( m_enqueue.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+					cell.data = t;
+					cell.seq.store( pos + 1, std::memory_order_release );
+					return true;
+				}
+			} else if ( diff < 0 ) {
+				return false;
+			} else {
+				pos = m_enqueue.load( std::memory_order_relaxed );
+			}
+		}
+	}
+
+	/*
+	 *  尽量压入 n 个元素，返回实际压入的个数
+	 */
+	int push_n( Tp const * in, int n ) {
+		int i = 0;
+		while ( i < n && try_push( in[i] ) ) {
+			++i;
+		}
+		return i;
+	}
+
+	bool try_pop( Tp & t ) {
+		std::size_t pos = m_dequeue.load( std::memory_order_relaxed );
+		for( ;; ) {
+			Cell & cell = m_cells[pos & MASK];
+			std::size_t seq = cell.seq.load( std::memory_order_acquire );
+			std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)( pos + 1 );
+			if ( diff == 0 ) {
+				if ( m_dequeue.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+					t = cell.data;
+					cell.seq.store( pos + CAPACITY, std::memory_order_release );
+					return true;
+				}
+			} else if ( diff < 0 ) {
+				return false;
+			} else {
+				pos = m_dequeue.load( std::memory_order_relaxed );
+			}
+		}
+	}
+
+	/*
+	 *  至多弹出 n 个元素，返回实际弹出的个数
+	 */
+	int pop_n( Tp * out, int n ) {
+		int i = 0;
+		while ( i < n && try_pop( out[i] ) ) {
+			++i;
+		}
+		return i;
+	}
+
+	/*
+	 *  并发时只是近似值
+	 */
+	int size() const {
+		std::ptrdiff_t n = (std::ptrdiff_t)( m_enqueue.load( std::memory_order_acquire ) - m_dequeue.load( std::memory_order_acquire ) );
+		return n < 0 ? 0 : n > CAPACITY ? CAPACITY : (int)n;
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	static int capacity() {
+		return CAPACITY;
+	}
+
+private:
+	MpmcRingPOD( MpmcRingPOD const & );
+	MpmcRingPOD & operator=( MpmcRingPOD const & );
+
+	static std::size_t const MASK = CAPACITY - 1;
+
+	struct Cell {
+		std::atomic< std::size_t > seq;
+		Tp                         data;
+	};
+
+	char                       m_pad0[BR_CACHE_LINE_SIZE];
+	std::atomic< std::size_t > m_enqueue;
+	char                       m_pad1[BR_CACHE_LINE_SIZE];
+	std::atomic< std::size_t > m_dequeue;
+	char                       m_pad2[BR_CACHE_LINE_SIZE];
+	Cell                       m_cells[CAPACITY];
+};
+
+}
@@ -0,0 +1,210 @@
+﻿/*
+ * @file  include/structure/XYArray.hpp
+ */
+#pragma once
+
+#include <config.hpp>
+
+#include <math/XYPair.hpp>
+#include <memory/RawAlloc.hpp>
+#include <structure/BulkPOD.hpp>
+
+namespace BR {
+/*
+ *  @brief XYArray 中一个元素的代理引用，x、y 分别引用两条分量数组中的同一位置
+ *
+ *  读写 p.x、p.y 的代码无需修改；需要值时可转换为 XYPair。
+ */
+template< class Tp >
+struct XYRef {
+	typedef Tp value_type;
+
+	Tp & x;
+	Tp & y;
+
+	XYRef( Tp & xx, Tp & yy ) : x( xx ), y( yy ) { }
+
+	// 代理的赋值写入被引用的分量，而不是重新绑定
+	XYRef const & operator=( XYRef const & rhs ) const {
+		x = rhs.x;
+		y = rhs.y;
+		return *this;
+	}
+
+	template< class Up >
+	XYRef const & operator=( XYPair< Up > const & rhs ) const {
+		x = rhs.x;
+		y = rhs.y;
+		return *this;
+	}
+
+	template< class Up >
+	operator XYPair< Up >() const {
+		return XYPair< Up >( x, y );
+	}
+};
+
+/*
+ *  @brief 按分量分开存放 XYPair 类元素的动态数组（SoA）
+ *  @param  Alloc  两条分量数组使用的原始内存分配器，默认 32 字节对齐，见 memory/RawAlloc.hpp
+ *
+ *  x 与 y 各自连续存放，xs()/ys() 可以直接交给 BulkPOD 等批量算法按满 SIMD 宽度处理，
+ *  translate/add_scaled 即是如此实现的。同时读写两个分量的逐点运算（如 pos += vel * dt）
+ *  与 AoS 访问的字节数相同，受内存带宽限制时两者相差无几；只用一个分量的遍历
+ *  （单方向平移、按 x 求范围或筛选）只需读写一半的内存，才是 SoA 的优势所在。
+ *  operator[] 返回 XYRef 代理。只适用于可平凡复制的分量类型。
+ */
+template< class Tp, class Alloc = AlignedRawAlloc< 32 > >
+class XYArray {
+public:
+	typedef XYPair< Tp >    value_type;
+	typedef XYRef< Tp >       reference;
+	typedef XYRef< Tp const > const_reference;
+
+	XYArray() : m_raw(), m_xs( BR_NULLPTR ), m_ys( BR_NULLPTR ), m_alloc( 0 ), m_size( 0 ) {
+	}
+
+	explicit XYArray( Alloc const & raw ) : m_raw( raw ), m_xs( BR_NULLPTR ), m_ys( BR_NULLPTR ), m_alloc( 0 ), m_size( 0 ) {
+	}
+
+	~XYArray() {
+		if ( m_alloc != 0 ) {
+			m_raw.deallocate( m_xs, sizeof(Tp)*m_alloc );
+			m_raw.deallocate( m_ys, sizeof(Tp)*m_alloc );
+		}
+	}
+
+	void push_back( Tp const & x, Tp const & y ) {
+		ensure_capacity( m_size+1 );
+		m_xs[m_size] = x;
+		m_ys[m_size] = y;
+		++m_size;
+	}
+
+	template< class Up >
+	void push_back( XYPair< Up > const & p ) {
+		push_back( p.x, p.y );
+	}
+
+	XYPair< Tp > pop_back() {
+		BR_ASSERT( m_size > 0 );
+		--m_size;
+		return XYPair< Tp >( m_xs[m_size], m_ys[m_size] );
+	}
+
+	/*
+	 *  新增的元素不初始化
+	 */
+	void resize( int n ) {
+		reserve( n );
+		m_size = n;
+	}
+
+	void reserve( int cap ) {
+		if ( cap > m_alloc ) {
+			reallocate( cap );
+		}
+	}
+
+	void clear() {
+		m_size = 0;
+	}
+
+	bool empty() const {
+		return m_size == 0;
+	}
+
+	reference operator[]( int i ) {
+		BR_ASSERT( i >= 0 && i < m_size );
+		return reference( m_xs[i], m_ys[i] );
+	}
+
+	const_reference operator[]( int i ) const {
+		BR_ASSERT( i >= 0 && i < m_size );
+		return const_reference( m_xs[i], m_ys[i] );
+	}
+
+	int size() const {
+		return m_size;
+	}
+
+	int capacity() const {
+		return m_alloc;
+	}
+
+	Tp * xs() {
+		return m_xs;
+	}
+
+	Tp const * xs() const {
+		return m_xs;
+	}
+
+	Tp * ys() {
+		return m_ys;
+	}
+
+	Tp const * ys() const {
+		return m_ys;
+	}
+
+	/*
+	 *  所有元素加上 ( dx, dy )
+	 */
+	void translate( Tp dx, Tp dy ) {
+		bulk_add( m_xs, m_size, dx );
+		bulk_add( m_ys, m_size, dy );
+	}
+
+	/*
+	 *  每个元素加上 rhs 中对应元素的 k 倍，如 pos.add_scaled( vel, dt )
+	 */
+	void add_scaled( XYArray const & rhs, Tp k ) {
+		BR_ASSERT( rhs.m_size == m_size );
+		bulk_axpy( m_xs, rhs.m_xs, m_size, k );
+		bulk_axpy( m_ys, rhs.m_ys, m_size, k );
+	}
+
+private:
+	XYArray( XYArray const & );
+	XYArray & operator=( XYArray const & );
+
+	void ensure_capacity( int cap ) {
+		if ( cap > m_alloc ) {
+			int new_alloc = m_alloc * 2;
+			reallocate( new_alloc > cap ? new_alloc : cap );
+		}
+	}
+
+	void reallocate( int new_alloc ) {
+		if ( m_alloc == 0 ) {
+			Tp * xs = (Tp *)m_raw.allocate( sizeof(Tp)*new_alloc );
+			try {
+				m_ys = (Tp *)m_raw.allocate( sizeof(Tp)*new_alloc );
+			} catch( ... ) {
+				m_raw.deallocate( xs, sizeof(Tp)*new_alloc );
+				throw;
+			}
+			m_xs = xs;
+		} else {
+			Tp * xs = (Tp *)m_raw.reallocate( m_xs, sizeof(Tp)*m_alloc, sizeof(Tp)*new_alloc, sizeof(Tp)*m_size );
+			try {
+				m_ys = (Tp *)m_raw.reallocate( m_ys, sizeof(Tp)*m_alloc, sizeof(Tp)*new_alloc, sizeof(Tp)*m_size );
+			} catch( ... ) {
+				// 把 x 分量缩回原容量，两条数组的大小才与 m_alloc 一致
+				m_xs = (Tp *)m_raw.reallocate( xs, sizeof(Tp)*new_alloc, sizeof(Tp)*m_alloc, sizeof(Tp)*m_size );
+				throw;
+			}
+			m_xs = xs;
+		}
+		m_alloc = new_alloc;
+	}
+
+	Alloc m_raw;
+	Tp  * m_xs;
+	Tp  * m_ys;
+	int   m_alloc;  // 每条分量数组的容量
+	int   m_size;
+};
+
+}
@@ -0,0 +1,127 @@
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <memory/Arena.hpp>
+#include <structure/DynArrPOD.hpp>
+
+using namespace std;
+using namespace BR;
+
+bool aligned( void const * p, size_t align ) {
+	return ( (size_t)p & ( align - 1 ) ) == 0;
+}
+
+/*
+ *  大小与对齐交错的分配互不重叠且各自对齐，跨块增长后仍然成立
+ */
+bool check_mixed( Arena & arena ) {
+	static size_t const SIZES[]  = { 1, 3, 8, 13, 64, 7, 200, 2 };
+	static size_t const ALIGNS[] = { 1, 2, 4, 8, 16, 32, 64 };
+	int const N = 1000;
+	vector< unsigned char * > mem( N );
+	bool ok = true;
+	for( int i=0; i<N; ++i ) {
+		size_t align = ALIGNS[ i % 7 ];
+		mem[i] = (unsigned char *)arena.allocate( SIZES[ i % 8 ], align );
+		ok = ok && aligned( mem[i], align );
+		memset( mem[i], i & 0xFF, SIZES[ i % 8 ] );
+	}
+	// 任何重叠都会让先写的内容被后写的覆盖
+	for( int i=0; i<N; ++i ) {
+		ok = ok && mem[i][0] == ( i & 0xFF ) && mem[i][ SIZES[ i % 8 ] - 1 ] == ( i & 0xFF );
+	}
+	return ok;
+}
+
+void test_Arena() {
+	bool ok = true;
+	{
+		Arena arena( 1024 );
+		ok = ok && arena.used() == 0 && arena.reserved() == 0;
+		ok = check_mixed( arena ) && ok;
+		std::size_t reserved = arena.reserved();
+		ok = ok && reserved > 1024 && arena.used() <= reserved;
+
+		// 默认按 max_align_t 对齐
+		ok = ok && aligned( arena.allocate( 1 ), alignof(std::max_align_t) );
+
+		// 超过块大小的请求单独成块
+		char * big = (char *)arena.allocate( 10000, 64 );
+		ok = ok && aligned( big, 64 ) && arena.reserved() >= reserved + 10000;
+		memset( big, 0, 10000 );
+
+		// reset 后复用已有的块，不再向系统申请
+		reserved = arena.reserved();
+		arena.reset();
+		ok = ok && arena.used() == 0;
+		ok = check_mixed( arena ) && ok;
+		ok = ok && arena.reserved() == reserved;
+
+		arena.release();
+		ok = ok && arena.reserved() == 0 && arena.used() == 0;
+	}
+	{
+		// used 等于已切出的字节数；换块后前一块扣除块头后的全部容量计入 used
+		size_t const HEADER = ( 2 * sizeof(void *) + alignof(max_align_t) - 1 ) / alignof(max_align_t) * alignof(max_align_t);
+		Arena arena( 256 );
+		arena.allocate( 100, 1 );
+		ok = ok && arena.used() == 100;
+		arena.allocate( 1000, 1 );
+		ok = ok && arena.used() == 256 - HEADER + 1000;
+	}
+	{
+		// 内联首块用完后溢出到堆上，release 只归还堆上的块
+		InlineArena< 512 > arena;
+		ok = ok && arena.reserved() == 512;
+		char * p = (char *)arena.allocate( 100 );
+		ok = ok && p >= (char *)&arena && p < (char *)&arena + sizeof(arena);
+		for( int i=0; i<20; ++i ) {
+			memset( arena.allocate( 100 ), i, 100 );
+		}
+		ok = ok && arena.reserved() > 512;
+		arena.release();
+		ok = ok && arena.reserved() == 512 && arena.used() == 0;
+		ok = ok && arena.allocate( 100 ) == p;
+	}
+	{
+		// DynArrPOD 溢出内联缓冲后从 Arena 取内存
+		Arena arena;
+		DynArrPOD< int, 4, ArenaRawAlloc > arr( ( ArenaRawAlloc( arena ) ) );
+		for( int i=0; i<1000; ++i ) {
+			arr.push_back( i );
+		}
+		bool same = true;
+		for( int i=0; i<1000; ++i ) {
+			same = same && arr[i] == i;
+		}
+		ok = ok && same && !arr.is_inline() && arena.used() >= 1000 * sizeof(int);
+	}
+	{
+		// ArenaMemPool 复用释放的项；Arena::reset 之后必须 clear，否则空闲链表指向已作废的内存
+		Arena arena;
+		ArenaMemPool< 24 > pool( arena );
+		void * a = pool.alloc();
+		void * b = pool.alloc();
+		ok = ok && a != b && aligned( a, 8 ) && aligned( b, 8 ) && pool.curr_alloc() == 2;
+		pool.free( a );
+		ok = ok && pool.alloc() == a && pool.curr_alloc() == 2;
+		pool.free( a );
+		pool.free( b );
+		arena.reset();
+		pool.clear();
+		ok = ok && pool.curr_alloc() == 0;
+		void * c = pool.alloc();
+		// clear 之后从 Arena 的开头重新切出，而不是取回旧的空闲项
+		ok = ok && c == a && pool.curr_alloc() == 1;
+		void * d = pool.alloc();
+		ok = ok && d == b;
+	}
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_Arena();
+	return 0;
+}
@@ -0,0 +1,110 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include <memory/RawAlloc.hpp>
+#include <structure/BulkPOD.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const COUNT  = 1 << 20;
+int const ROUNDS = 100;
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+template< class Tp, class Bulk, class Scalar >
+bool bench( char const * name, Bulk bulk, Scalar scalar, Tp const * mem, int n ) {
+	long long bulk_check = 0, scalar_check = 0;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		bulk_check += (long long)bulk( mem, n );
+	}
+	double bulk_ms = elapsed( start );
+
+	start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		scalar_check += (long long)scalar( mem, n );
+	}
+	double scalar_ms = elapsed( start );
+
+	cout << name << ": bulk " << bulk_ms << " ms, scalar " << scalar_ms << " ms\n";
+	return bulk_check == scalar_check;
+}
+
+template< class Tp >
+bool check_small( Tp const * mem ) {
+	// 覆盖所有不足一个向量宽度的尾部长度
+	bool ok = true;
+	for( int n=1; n<=20; ++n ) {
+		ok = ok && bulk_sum( mem, n ) == detail::bulk_sum_scalar( mem, n );
+		ok = ok && bulk_min( mem, n ) == detail::bulk_min_scalar( mem, n );
+		ok = ok && bulk_max( mem, n ) == detail::bulk_max_scalar( mem, n );
+		ok = ok && bulk_find( mem, n, mem[n-1] ) == detail::bulk_find_scalar( mem, n, mem[n-1] );
+		ok = ok && bulk_count( mem, n, mem[0] ) == detail::bulk_count_scalar( mem, n, mem[0] );
+	}
+	return ok;
+}
+
+void test_BulkPOD() {
+	cout << "avx2: " << ( simd::has_avx2() ? "yes" : "no" ) << "\n";
+
+	DynArrPOD< int, 16, AlignedRawAlloc<> > ints;
+	DynArrPOD< float, 16, AlignedRawAlloc<> > floats;
+	srand( 1 );
+	for( int i=0; i<COUNT; ++i ) {
+		int v = rand() % 1000 - 500;
+		ints.push_back( v );
+		floats.push_back( v * 0.5f );
+	}
+
+	bool ok = true;
+	ok = ok && bench( "int sum", bulk_sum< int >, detail::bulk_sum_scalar< int >, ints.mem(), ints.size() );
+	ok = ok && bench( "int min", bulk_min< int >, detail::bulk_min_scalar< int >, ints.mem(), ints.size() );
+	ok = ok && bench( "int max", bulk_max< int >, detail::bulk_max_scalar< int >, ints.mem(), ints.size() );
+	// 半浮点数相加在 double 中是精确的，两种累加顺序结果相同
+	ok = ok && bench( "float sum", bulk_sum< float >, detail::bulk_sum_scalar< float >, floats.mem(), floats.size() );
+	ok = ok && bench( "float min", bulk_min< float >, detail::bulk_min_scalar< float >, floats.mem(), floats.size() );
+	ok = ok && bench( "float max", bulk_max< float >, detail::bulk_max_scalar< float >, floats.mem(), floats.size() );
+
+	ints[COUNT-3] = 100000;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	int found = 0;
+	for( int r=0; r<ROUNDS; ++r ) {
+		found += bulk_find( ints, 100000 ) + bulk_count( ints, 0 );
+	}
+	double bulk_ms = elapsed( start );
+	start = chrono::steady_clock::now();
+	int scalar_found = 0;
+	for( int r=0; r<ROUNDS; ++r ) {
+		scalar_found += detail::bulk_find_scalar( ints.mem(), ints.size(), 100000 ) + detail::bulk_count_scalar( ints.mem(), ints.size(), 0 );
+	}
+	double scalar_ms = elapsed( start );
+	cout << "int find+count: bulk " << bulk_ms << " ms, scalar " << scalar_ms << " ms\n";
+	ok = ok && found == scalar_found;
+
+	ok = ok && check_small( ints.mem() ) && check_small( floats.mem() );
+
+	bulk_fill( floats, 1.5f );
+	ok = ok && bulk_count( floats, 1.5f ) == COUNT && bulk_find( floats, 2.0f ) == -1;
+
+	// 其他类型使用标量实现
+	short shorts[5] = { 3, -1, 4, 1, -5 };
+	ok = ok && bulk_sum( shorts, 5 ) == 2 && bulk_min( shorts, 5 ) == -5 && bulk_find( shorts, 5, (short)4 ) == 2;
+
+	// 累加类型保留 long double 的小数部分与 unsigned long long 的全部范围
+	long double halves[3] = { 0.5L, 0.5L, 0.5L };
+	unsigned long long big[2] = { ~0ull, 0 };
+	unsigned char bytes[3] = { 200, 200, 200 };
+	ok = ok && bulk_sum( halves, 3 ) == 1.5L && bulk_sum( big, 2 ) == ~0ull && bulk_sum( bytes, 3 ) == 600;
+
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_BulkPOD();
+	return 0;
+}
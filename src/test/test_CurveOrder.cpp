@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <math/XYPair.hpp>
+#include <spatial/CurveOrder.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const COUNT = 2000000;
+
+// 单核机器上也要走并行路径，线程数至少取 4
+int const THREADS = max( 4, (int)thread::hardware_concurrency() );
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+/*
+ *  相邻两点的平均距离，越小说明顺序的空间局部性越好
+ */
+template< class Tp >
+double mean_step( vector< XYPair< Tp > > const & pts ) {
+	double sum = 0;
+	for( size_t i=1; i<pts.size(); ++i ) {
+		double dx = (double)pts[i].x - pts[i-1].x, dy = (double)pts[i].y - pts[i-1].y;
+		sum += sqrt( dx * dx + dy * dy );
+	}
+	return sum / ( pts.size() - 1 );
+}
+
+/*
+ *  Hilbert 序号的逐位定义，查表实现应与之一致
+ */
+uint32_t hilbert_reference( uint32_t x, uint32_t y ) {
+	uint32_t d = 0;
+	for( uint32_t s=1u<<15; s>0; s>>=1 ) {
+		uint32_t rx = ( x & s ) ? 1 : 0;
+		uint32_t ry = ( y & s ) ? 1 : 0;
+		d += s * s * ( ( 3 * rx ) ^ ry );
+		if ( ry == 0 ) {
+			if ( rx == 1 ) {
+				x = s - 1 - x;
+				y = s - 1 - y;
+			}
+			swap( x, y );
+		}
+	}
+	return d;
+}
+
+bool test_keys() {
+	bool ok = true;
+	// Morton 键与逐位交错的结果一致，BMI2 与移位掩码两条路径结果一致
+	vector< XYPair< int > > pts;
+	pts.push_back( XYPair< int >( 0, 0 ) );
+	pts.push_back( XYPair< int >( 65535, 65535 ) );
+	for( int i=0; i<10000; ++i ) {
+		pts.push_back( XYPair< int >( rand() & 0xFFFF, rand() & 0xFFFF ) );
+	}
+	vector< uint32_t > keys( pts.size() );
+	curve_keys( &pts[0], (int)pts.size(), &keys[0], CURVE_MORTON );
+	for( size_t i=0; i<pts.size(); ++i ) {
+		uint32_t expect = 0;
+		for( int b=0; b<16; ++b ) {
+			expect |= ( ( pts[i].x >> b ) & 1u ) << ( 2 * b );
+			expect |= ( ( pts[i].y >> b ) & 1u ) << ( 2 * b + 1 );
+		}
+		ok = ok && keys[i] == expect && morton_key( pts[i].x, pts[i].y ) == expect;
+		ok = ok && hilbert_key( pts[i].x, pts[i].y ) == hilbert_reference( pts[i].x, pts[i].y );
+	}
+
+	// Hilbert 顺序遍历整个网格时每一步恰好移动一格
+	pts.clear();
+	for( int y=0; y<256; ++y ) {
+		for( int x=0; x<256; ++x ) {
+			pts.push_back( XYPair< int >( x, y ) );
+		}
+	}
+	random_shuffle( pts.begin(), pts.end() );
+	curve_sort( &pts[0], (int)pts.size(), CURVE_HILBERT, THREADS );
+	ok = ok && pts[0].x == 0 && pts[0].y == 0;
+	for( size_t i=1; i<pts.size(); ++i ) {
+		ok = ok && abs( pts[i].x - pts[i-1].x ) + abs( pts[i].y - pts[i-1].y ) == 1;
+	}
+	return ok;
+}
+
+bool test_radix_sort() {
+	bool ok = true;
+	int const sizes[] = { 0, 1, 100, 300000 };
+	uint32_t const masks[] = { 0xFFFFFFFFu, 0x00FF00F0u, 0x7u };
+	for( int s=0; s<4; ++s ) {
+		for( int m=0; m<3; ++m ) {
+			int n = sizes[s];
+			vector< pair< uint32_t, int > > expect( n );
+			vector< uint32_t > keys( n + 1 );
+			vector< int > ids( n + 1 );
+			for( int i=0; i<n; ++i ) {
+				keys[i] = ( (uint32_t)rand() << 16 ^ (uint32_t)rand() ) & masks[m];
+				ids[i] = i;
+				expect[i] = make_pair( keys[i], i );
+			}
+			stable_sort( expect.begin(), expect.end() );
+			radix_sort( &keys[0], &ids[0], n, m == 0 ? 1 : THREADS );
+			for( int i=0; i<n; ++i ) {
+				ok = ok && keys[i] == expect[i].first && ids[i] == expect[i].second;
+			}
+		}
+	}
+	return ok;
+}
+
+template< class Tp >
+void bench( char const * name, Tp range ) {
+	vector< XYPair< Tp > > pts( COUNT );
+	for( int i=0; i<COUNT; ++i ) {
+		pts[i] = XYPair< Tp >( (Tp)( rand() / ( RAND_MAX + 1.0 ) * range ), (Tp)( rand() / ( RAND_MAX + 1.0 ) * range ) );
+	}
+
+	vector< XYPair< Tp > > work( pts );
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	sort( work.begin(), work.end(), XYPair< Tp >::template order_x< Tp, Tp > );
+	double sort_ms = elapsed( start );
+	double sort_step = mean_step( work );
+
+	cout << name << ": std::sort order_x " << sort_ms << " ms, mean step " << sort_step << "\n";
+	CurveType const curves[] = { CURVE_MORTON, CURVE_HILBERT };
+	char const * curve_names[] = { "morton ", "hilbert" };
+	for( int c=0; c<2; ++c ) {
+		work = pts;
+		start = chrono::steady_clock::now();
+		curve_sort( &work[0], COUNT, curves[c], 1 );
+		double serial_ms = elapsed( start );
+
+		work = pts;
+		start = chrono::steady_clock::now();
+		curve_sort( &work[0], COUNT, curves[c], THREADS );
+		double parallel_ms = elapsed( start );
+
+		cout << "  " << curve_names[c] << " serial " << serial_ms << " ms, " << THREADS << " threads " << parallel_ms << " ms, mean step " << mean_step( work ) << "\n";
+	}
+}
+
+void test_CurveOrder() {
+	bool ok = test_keys();
+	ok = test_radix_sort() && ok;
+
+	cout << "reorder " << COUNT << " points\n";
+	bench< int >( "XYPair<int>  ", 1000000 );
+	bench< float >( "XYPair<float>", 1.0f );
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_CurveOrder();
+	return 0;
+}
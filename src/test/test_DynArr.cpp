@@ -0,0 +1,124 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <structure/DynArr.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const COUNT  = 1000000;
+int const ROUNDS = 10;
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+template< class Arr, class Make >
+double bench( Make make, long long & checksum ) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		Arr arr;
+		for( int i=0; i<COUNT; ++i ) {
+			arr.emplace_back( make( i ) );
+		}
+		checksum += (long long)arr.size();
+	}
+	return elapsed( start );
+}
+
+int make_int( int i ) {
+	return i;
+}
+
+string make_string( int i ) {
+	return string( 24 + i % 8, 'a' + i % 26 );
+}
+
+/*
+ *  第 throw_at 次复制构造时抛出异常，并记录存活的对象数
+ */
+struct Fragile {
+	static int live;
+	static int copies;
+	static int throw_at;
+
+	Fragile() {
+		++live;
+	}
+
+	Fragile( Fragile const & ) {
+		if ( ++copies == throw_at ) {
+			throw runtime_error( "copy" );
+		}
+		++live;
+	}
+
+	~Fragile() {
+		--live;
+	}
+};
+
+int Fragile::live = 0;
+int Fragile::copies = 0;
+int Fragile::throw_at = 0;
+
+void test_DynArr() {
+	long long sum_vec = 0, sum_arr = 0;
+
+	double vec_ms = bench< vector< int > >( make_int, sum_vec );
+	double arr_ms = bench< DynArr< int > >( make_int, sum_arr );
+	cout << "int emplace_back: std::vector " << vec_ms << " ms, DynArr " << arr_ms << " ms\n";
+
+	vec_ms = bench< vector< string > >( make_string, sum_vec );
+	arr_ms = bench< DynArr< string > >( make_string, sum_arr );
+	cout << "string emplace_back: std::vector " << vec_ms << " ms, DynArr " << arr_ms << " ms\n";
+
+	bool ok = sum_vec == sum_arr;
+
+	// 只能移动的元素在扩容时必须被移动
+	DynArr< unique_ptr< int > > owners;
+	for( int i=0; i<1000; ++i ) {
+		owners.emplace_back( new int( i ) );
+	}
+	owners.shrink_to_fit();
+	ok = ok && owners.capacity() == 1000 && *owners[999] == 999;
+
+	// 参数引用自身元素时扩容也必须安全
+	DynArr< string > strs;
+	strs.push_back( "self" );
+	for( int i=0; i<100; ++i ) {
+		strs.push_back( strs[0] );
+	}
+	ok = ok && strs.size() == 101 && strs.back() == "self";
+
+	DynArr< string > copy( strs );
+	DynArr< string > moved( std::move( copy ) );
+	ok = ok && copy.size() == 0 && moved.size() == 101;
+
+	// 复制构造中途抛出时已构造的元素全部析构
+	{
+		DynArr< Fragile > src;
+		for( int i=0; i<10; ++i ) {
+			src.emplace_back();
+		}
+		Fragile::throw_at = Fragile::copies + 5;
+		try {
+			DynArr< Fragile > dst( src );
+			ok = false;
+		} catch( runtime_error const & ) {
+		}
+		ok = ok && Fragile::live == 10;
+	}
+	ok = ok && Fragile::live == 0;
+
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_DynArr();
+	return 0;
+}
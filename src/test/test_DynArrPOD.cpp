@@ -0,0 +1,189 @@
+#include <iostream>
+#include <utility>
+
+#include <structure/DynArrPOD.hpp>
+
+using namespace std;
+using namespace BR;
+
+typedef DynArrPOD< int, 8 > Arr;
+
+/*
+ *  arr 中依次是 base, base+1, ..., base+n-1
+ */
+bool holds( Arr const & arr, int base, int n ) {
+	bool ok = arr.size() == n;
+	for( int i=0; ok && i<n; ++i ) {
+		ok = arr[i] == base + i;
+	}
+	return ok;
+}
+
+void fill( Arr & arr, int base, int n ) {
+	for( int i=0; i<n; ++i ) {
+		arr.push_back( base + i );
+	}
+}
+
+/*
+ *  元素存放在数组对象内部
+ */
+bool inside( Arr const & arr ) {
+	char const * p = (char const *)arr.mem();
+	return arr.is_inline() && p >= (char const *)&arr && p < (char const *)&arr + sizeof(arr);
+}
+
+bool test_sbo() {
+	bool ok = true;
+
+	// 不超过 INIT 个元素时留在内联缓冲区
+	Arr small;
+	ok = ok && inside( small ) && small.capacity() == 8;
+	fill( small, 0, 8 );
+	ok = ok && inside( small ) && holds( small, 0, 8 );
+
+	// 第 INIT+1 个元素时转到堆上，已有元素随之搬过去
+	Arr big;
+	fill( big, 100, 9 );
+	ok = ok && !big.is_inline() && big.capacity() >= 9 && holds( big, 100, 9 );
+	fill( big, 109, 991 );
+	ok = ok && holds( big, 100, 1000 );
+
+	// 复制：内联的副本仍是内联的，堆上的副本有自己的缓冲区
+	Arr small_copy( small );
+	Arr big_copy( big );
+	ok = ok && inside( small_copy ) && holds( small_copy, 0, 8 );
+	ok = ok && !big_copy.is_inline() && big_copy.mem() != big.mem() && holds( big_copy, 100, 1000 );
+	big_copy[0] = -1;
+	ok = ok && big[0] == 100;
+
+	// 复制赋值：堆上的内容赋给内联数组，内联的内容赋给堆上的数组
+	Arr assigned;
+	fill( assigned, 0, 3 );
+	assigned = big;
+	ok = ok && holds( assigned, 100, 1000 ) && assigned.mem() != big.mem();
+	assigned = small;
+	ok = ok && holds( assigned, 0, 8 );
+	assigned = assigned;
+	ok = ok && holds( assigned, 0, 8 );
+
+	// 移动：堆上的缓冲区被接管，内联的元素被复制；源数组变为空的内联数组
+	int const * big_mem = big.mem();
+	Arr big_moved( std::move( big ) );
+	ok = ok && big_moved.mem() == big_mem && holds( big_moved, 100, 1000 );
+	ok = ok && big.empty() && inside( big ) && big.capacity() == 8;
+	Arr small_moved( std::move( small ) );
+	ok = ok && inside( small_moved ) && holds( small_moved, 0, 8 ) && small.empty();
+
+	// 移动赋值后源数组仍可继续使用
+	Arr target;
+	fill( target, 0, 20 );
+	target = std::move( big_moved );
+	ok = ok && target.mem() == big_mem && holds( target, 100, 1000 ) && big_moved.empty();
+	fill( big_moved, 7, 10 );
+	ok = ok && holds( big_moved, 7, 10 );
+
+	// 收缩：多余容量还给分配器，元素不超过 INIT 个时回到内联缓冲区
+	while ( target.size() > 20 ) {
+		target.pop_back();
+	}
+	target.shrink_to_fit();
+	ok = ok && !target.is_inline() && target.capacity() == 20 && holds( target, 100, 20 );
+	while ( target.size() > 5 ) {
+		target.pop_back();
+	}
+	target.shrink_to_fit();
+	ok = ok && inside( target ) && target.capacity() == 8 && holds( target, 100, 5 );
+	fill( target, 105, 100 );
+	ok = ok && holds( target, 100, 105 );
+
+	if ( !ok ) {
+		cout << "small buffer: FAIL\n";
+	}
+	return ok;
+}
+
+/*
+ *  逐个追加到 n 个元素；每次扩容后检查已有元素完好，容量按增长因子增长
+ */
+template< class Big >
+bool check_growth( Big & arr, int n, float factor ) {
+	arr.set_growth_factor( factor );
+	bool ok = true;
+	int grows = 0;
+	for( int i=0; i<n; ++i ) {
+		int cap = arr.capacity();
+		arr.push_back( i );
+		if ( arr.capacity() != cap ) {
+			++grows;
+			ok = ok && arr.capacity() == int( cap * factor );
+			for( int j=0; ok && j<=i; ++j ) {
+				ok = arr[j] == j;
+			}
+		}
+	}
+	return ok && arr.size() == n && grows > 10;
+}
+
+/*
+ *  PageRawAlloc：超过阈值的缓冲区按页映射，跨过阈值与多个页倍数重新映射后内容不变
+ */
+bool test_page_alloc() {
+	size_t const THRESHOLD = 64*1024;
+	typedef PageRawAlloc< THRESHOLD > Alloc;
+	Alloc raw;
+	bool ok = true;
+
+	// 从堆上的小缓冲区长到映射的大缓冲区，再按页倍数继续增长，最后缩回堆上
+	size_t const steps[] = { 1000, THRESHOLD - 8, THRESHOLD, 3*THRESHOLD + 100, 17*THRESHOLD, 64*THRESHOLD + 4095, 2*THRESHOLD, 100 };
+	size_t const N = sizeof(steps) / sizeof(steps[0]);
+	unsigned char * mem = (unsigned char *)raw.allocate( steps[0] );
+	for( size_t i=0; i<steps[0]; ++i ) {
+		mem[i] = (unsigned char)( i * 7 );
+	}
+	for( size_t s=1; s<N; ++s ) {
+		size_t used = steps[s-1] < steps[s] ? steps[s-1] : steps[s];
+		mem = (unsigned char *)raw.reallocate( mem, steps[s-1], steps[s], used );
+		if ( steps[s] >= THRESHOLD ) {
+			ok = ok && ( (size_t)mem & 4095 ) == 0;
+		}
+		for( size_t i=0; ok && i<used; ++i ) {
+			ok = mem[i] == (unsigned char)( i * 7 );
+		}
+		for( size_t i=used; i<steps[s]; ++i ) {
+			mem[i] = (unsigned char)( i * 7 );
+		}
+	}
+	raw.deallocate( mem, steps[N-1] );
+
+	// DynArrPOD 在映射的缓冲区上增长，跨过多个页倍数
+	{
+		DynArrPOD< int, 4, Alloc > arr;
+		ok = check_growth( arr, 4*1024*1024, 2.0f ) && ok;
+	}
+	{
+		DynArrPOD< int, 4, Alloc > arr;
+		ok = check_growth( arr, 1024*1024, 1.5f ) && ok;
+		arr.shrink_to_fit();
+		ok = ok && arr.capacity() == 1024*1024 && arr[1024*1024-1] == 1024*1024-1;
+	}
+	{
+		DynArrPOD< int, 4 > arr;
+		ok = check_growth( arr, 1024*1024, 1.25f ) && ok;
+	}
+	if ( !ok ) {
+		cout << "growth: FAIL\n";
+	}
+	return ok;
+}
+
+void test_DynArrPOD() {
+	bool ok = test_sbo();
+	ok = test_page_alloc() && ok;
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_DynArrPOD();
+	return 0;
+}
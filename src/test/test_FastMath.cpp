@@ -0,0 +1,152 @@
+#include <chrono>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <math/FastMath.hpp>
+#include <math/Vector2D.hpp>
+#include <math/Vector2DBulk.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const COUNT  = 1 << 16;
+int const ROUNDS = 100;
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+struct Sqrt {
+	template< class Math >
+	static float apply( Vector2D< float > const & v ) {
+		return Math::sqrt( v.x );
+	}
+};
+
+struct Rsqrt {
+	template< class Math >
+	static float apply( Vector2D< float > const & v ) {
+		return Math::rsqrt( v.x );
+	}
+};
+
+struct Atan2 {
+	template< class Math >
+	static float apply( Vector2D< float > const & v ) {
+		return v.arg< Math >();
+	}
+};
+
+struct Unit {
+	template< class Math >
+	static float apply( Vector2D< float > const & v ) {
+		return v.unit< Math >().x;
+	}
+};
+
+/*
+ *  输出一行：精确与近似版本各自的耗时，以及近似版本的最大误差；relative 为 false 时比较绝对误差
+ */
+template< class Op >
+bool row( char const * name, vector< Vector2D< float > > const & vs, bool relative, double bound ) {
+	vector< float > exact( vs.size() ), fast( vs.size() );
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		for( size_t i=0; i<vs.size(); ++i ) {
+			exact[i] = Op::template apply< ExactMath >( vs[i] );
+		}
+	}
+	double exact_ms = elapsed( start );
+
+	start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		for( size_t i=0; i<vs.size(); ++i ) {
+			fast[i] = Op::template apply< FastMath >( vs[i] );
+		}
+	}
+	double fast_ms = elapsed( start );
+
+	double max_err = 0;
+	for( size_t i=0; i<vs.size(); ++i ) {
+		double err = std::fabs( (double)fast[i] - exact[i] );
+		if ( relative ) {
+			err /= std::fabs( (double)exact[i] );
+		}
+		if ( err > max_err ) {
+			max_err = err;
+		}
+	}
+	cout << name << "\t" << exact_ms << "\t\t" << fast_ms << "\t\t" << max_err << ( relative ? " rel" : " abs" ) << "\n";
+	return max_err < bound;
+}
+
+void test_FastMath() {
+	vector< Vector2D< float > > vs;
+	for( int i=0; i<COUNT; ++i ) {
+		float x = ( rand() % 20001 - 10000 ) / 37.0f;
+		float y = ( rand() % 20001 - 10000 ) / 53.0f;
+		vs.push_back( Vector2D< float >( x == 0 ? 1.0f : x, y ) );
+	}
+	// sqrt/rsqrt 只接受正数，把 x 换成 x*x + y*y
+	vector< Vector2D< float > > squares( vs );
+	for( size_t i=0; i<squares.size(); ++i ) {
+		squares[i].x = vs[i].magnitude_sqr();
+	}
+
+	bool ok = true;
+	cout << "op\texact(ms)\tfast(ms)\tmax error\n";
+	ok = row< Sqrt >( "sqrt", squares, true, 1e-4 ) && ok;
+	ok = row< Rsqrt >( "rsqrt", squares, true, 1e-4 ) && ok;
+	ok = row< Atan2 >( "atan2", vs, false, 2e-5 ) && ok;
+	ok = row< Unit >( "unit", vs, false, 1e-4 ) && ok;
+
+	// 坐标轴与原点
+	ok = ok && FastMath::atan2( 0.0f, 0.0f ) == 0.0f && FastMath::sqrt( 0.0f ) == 0.0f;
+	ok = ok && std::fabs( FastMath::atan2( 1.0f, 0.0f ) - 1.5707963f ) < 1e-6f && std::fabs( FastMath::atan2( 0.0f, -1.0f ) - 3.1415927f ) < 1e-6f;
+
+	// double 参数超出 float 的范围时仍然有效
+	double const wide[] = { 1e300, DBL_MAX, 1e-300, 4e-320, 3.5e38, 1e-40, 2.0, 0.7 };
+	for( size_t i=0; i<sizeof(wide)/sizeof(wide[0]); ++i ) {
+		double x = wide[i];
+		ok = ok && std::fabs( FastMath::sqrt( x ) / std::sqrt( x ) - 1 ) < 1e-6;
+		ok = ok && std::fabs( FastMath::rsqrt( x ) * std::sqrt( x ) - 1 ) < 1e-6;
+		ok = ok && std::fabs( FastMath::atan2( x, -x ) - std::atan2( x, -x ) ) < 1e-5;
+		ok = ok && std::fabs( FastMath::atan2( -x, 3 * x ) - std::atan2( -x, 3 * x ) ) < 1e-5;
+	}
+	Vector2D< double > huge( 3e150, 4e150 );
+	ok = ok && std::fabs( huge.magnitude< FastMath >() / 5e150 - 1 ) < 1e-6;
+	ok = ok && std::fabs( huge.unit< FastMath >().x - 0.6 ) < 1e-6;
+
+	Vector2D< float > v( 3.0f, 4.0f );
+	ok = ok && v.magnitude() == 5.0f && std::fabs( v.magnitude< FastMath >() - 5.0f ) < 5e-4f;
+	v.unitize< FastMath >();
+	ok = ok && std::fabs( v.x - 0.6f ) < 1e-4f && std::fabs( v.y - 0.8f ) < 1e-4f;
+
+	// 默认的精确策略直接除以长度：与 vec2_normalize 逐位一致，整数向量按整数除法
+	vector< Vector2D< float > > units( vs.size() );
+	vec2_normalize( &units[0], &vs[0], (int)vs.size() );
+	int mismatches = 0;
+	for( size_t i=0; i<vs.size(); ++i ) {
+		Vector2D< float > u = vs[i].unit();
+		Vector2D< float > w( vs[i] );
+		w.unitize();
+		if ( memcmp( &u, &units[i], sizeof(u) ) != 0 || memcmp( &w, &units[i], sizeof(w) ) != 0 ) {
+			++mismatches;
+		}
+	}
+	ok = ok && mismatches == 0;
+	Vector2D< int > iv( 0, 5 ), iw( -7, 0 ), i34( 3, 4 );
+	ok = ok && iv.unit().eql( 0, 1 ) && iw.unit().eql( -1, 0 ) && i34.unit().eql( 0, 0 );
+
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_FastMath();
+	return 0;
+}
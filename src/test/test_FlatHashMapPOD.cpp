@@ -0,0 +1,141 @@
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include <math/XYPair.hpp>
+#include <structure/FlatHashMapPOD.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const COUNT = 1 << 20;
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+template< class Key >
+struct KeyEqual {
+	bool operator()( Key const & lhs, Key const & rhs ) const {
+		return lhs == rhs;
+	}
+};
+
+template<>
+struct KeyEqual< XYPair< int > > {
+	bool operator()( XYPair< int > const & lhs, XYPair< int > const & rhs ) const {
+		return lhs.x == rhs.x && lhs.y == rhs.y;
+	}
+};
+
+int make_key( int i, int ) {
+	// 乘以奇数在模 2^32 下是双射，键互不相同
+	return (int)( (unsigned)i * 2654435761u );
+}
+
+XYPair< int > make_key( int i, XYPair< int > ) {
+	return XYPair< int >( i % 1024, i / 1024 * 3 );
+}
+
+/*
+ *  依次插入 COUNT 个键、查找全部命中的键与同样多的未命中键、删除一半的键
+ */
+template< class Map, class Key >
+bool bench_std( Map & map, vector< Key > const & keys, vector< Key > const & misses, double * ms ) {
+	long long check = 0;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int i=0; i<COUNT; ++i ) {
+		map[keys[i]] = i;
+	}
+	ms[0] = elapsed( start );
+
+	start = chrono::steady_clock::now();
+	for( int i=0; i<COUNT; ++i ) {
+		typename Map::iterator it = map.find( keys[i] );
+		check += it == map.end() ? -1 : it->second;
+	}
+	for( int i=0; i<COUNT; ++i ) {
+		check += map.find( misses[i] ) == map.end() ? 0 : 1;
+	}
+	ms[1] = elapsed( start );
+
+	start = chrono::steady_clock::now();
+	for( int i=0; i<COUNT; i+=2 ) {
+		map.erase( keys[i] );
+	}
+	ms[2] = elapsed( start );
+
+	return check == (long long)COUNT * ( COUNT - 1 ) / 2 && (int)map.size() == COUNT / 2;
+}
+
+template< class Key >
+bool bench_key( char const * name ) {
+	vector< Key > keys, misses;
+	for( int i=0; i<COUNT; ++i ) {
+		keys.push_back( make_key( i, Key() ) );
+		misses.push_back( make_key( i + COUNT, Key() ) );
+	}
+
+	double std_ms[3], flat_ms[3];
+	unordered_map< Key, int, PODHash< Key >, KeyEqual< Key > > std_map;
+	bool ok = bench_std( std_map, keys, misses, std_ms );
+
+	FlatHashMapPOD< Key, int > flat;
+	long long check = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int i=0; i<COUNT; ++i ) {
+		flat[keys[i]] = i;
+	}
+	flat_ms[0] = elapsed( start );
+	start = chrono::steady_clock::now();
+	for( int i=0; i<COUNT; ++i ) {
+		int const * val = flat.find( keys[i] );
+		check += val == BR_NULLPTR ? -1 : *val;
+	}
+	for( int i=0; i<COUNT; ++i ) {
+		check += flat.contains( misses[i] ) ? 1 : 0;
+	}
+	flat_ms[1] = elapsed( start );
+	start = chrono::steady_clock::now();
+	for( int i=0; i<COUNT; i+=2 ) {
+		flat.erase( keys[i] );
+	}
+	flat_ms[2] = elapsed( start );
+	ok = ok && check == (long long)COUNT * ( COUNT - 1 ) / 2 && flat.size() == COUNT / 2;
+
+	char const * ops[3] = { "insert", "lookup", "erase" };
+	for( int i=0; i<3; ++i ) {
+		cout << name << " " << ops[i] << ": std::unordered_map " << std_ms[i] << " ms, FlatHashMapPOD " << flat_ms[i] << " ms\n";
+	}
+	return ok;
+}
+
+void test_FlatHashMapPOD() {
+	bool ok = bench_key< int >( "int" );
+	ok = bench_key< XYPair< int > >( "XYPair<int>" ) && ok;
+
+	// 删除后的墓碑被复用，反复插入删除不会无限扩容
+	FlatHashMapPOD< int, int > churn;
+	for( int i=0; i<100000; ++i ) {
+		churn.insert( i, i );
+		ok = ok && !churn.insert( i, -1 ) && *churn.find( i ) == i;
+		churn.erase( i - 8 );
+	}
+	ok = ok && churn.size() == 8 && churn.capacity() <= 64;
+
+	int sum = 0;
+	churn.for_each( [&]( int const & key, int & val ) { sum += key - val; } );
+	ok = ok && sum == 0 && !churn.contains( 99991 ) && churn.contains( 99992 );
+
+	churn.clear();
+	ok = ok && churn.empty() && churn.find( 99999 ) == BR_NULLPTR;
+
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_FlatHashMapPOD();
+	return 0;
+}
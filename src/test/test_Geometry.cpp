@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <math/Point2D.hpp>
+#include <geometry/Predicates.hpp>
+#include <geometry/ConvexHull.hpp>
+#include <geometry/ClosestPair.hpp>
+#include <geometry/Polygon.hpp>
+
+using namespace std;
+using namespace BR;
+
+typedef Point2D< double > Pt;
+
+// 单核机器上也要走并行路径，线程数至少取 4
+int const THREADS = max( 4, (int)thread::hardware_concurrency() );
+
+double const PI = 3.14159265358979323846;
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+double random_unit() {
+	return rand() / ( RAND_MAX + 1.0 );
+}
+
+/*
+ *  Kettner 等人的经典反例：a 在 0.5 附近逐 ulp 移动，b、c 固定在直线 y = x 上。
+ *  坐标都是 2^-53 的整数倍，放大后用 128 位整数算出真实符号
+ */
+bool test_orient2d() {
+	double const ULP = ldexp( 1.0, -53 );
+	long long const SCALE = 1LL << 53;
+	Pt b( 12, 12 ), c( 24, 24 );
+	bool ok = true;
+	int naive_wrong = 0;
+	for( int i=0; i<256; ++i ) {
+		for( int j=0; j<256; ++j ) {
+			Pt a( 0.5 + i * ULP, 0.5 + j * ULP );
+			__int128 ax = SCALE / 2 + i, ay = SCALE / 2 + j;
+			__int128 bx = (__int128)12 * SCALE, by = bx, cx = (__int128)24 * SCALE, cy = cx;
+			__int128 det = ( bx - ax ) * ( cy - ay ) - ( by - ay ) * ( cx - ax );
+			int expect = ( det > 0 ) - ( det < 0 );
+			ok = ok && orient2d( a, b, c ) == expect && orient2d( b, c, a ) == expect && orient2d( b, a, c ) == -expect;
+			double naive = ( b.x - a.x ) * ( c.y - a.y ) - ( b.y - a.y ) * ( c.x - a.x );
+			naive_wrong += ( ( naive > 0 ) - ( naive < 0 ) ) != expect;
+		}
+	}
+	cout << "orient2d: naive double formula wrong on " << naive_wrong << " of 65536 near-collinear triples\n";
+	return ok;
+}
+
+bool same( vector< Pt > const & lhs, vector< Pt > const & rhs ) {
+	bool ok = lhs.size() == rhs.size();
+	for( size_t i=0; i<lhs.size() && ok; ++i ) {
+		ok = lhs[i].eql( rhs[i] );
+	}
+	return ok;
+}
+
+bool check_hull( vector< Pt > const & pts, vector< Pt > const & hull ) {
+	int h = (int)hull.size();
+	bool ok = h >= 3;
+	for( int i=0; i<h && ok; ++i ) {
+		ok = orient2d( hull[i], hull[(i+1)%h], hull[(i+2)%h] ) > 0;
+		for( size_t j=0; j<pts.size() && ok; ++j ) {
+			ok = orient2d( hull[i], hull[(i+1)%h], pts[j] ) >= 0;
+		}
+	}
+	return ok;
+}
+
+bool test_convex_hull() {
+	int const COUNT = 1000000;
+	vector< Pt > pts, hull, parallel;
+	for( int i=0; i<COUNT; ++i ) {
+		double r = sqrt( random_unit() ), t = 2 * PI * random_unit();
+		pts.push_back( Pt( r * cos( t ), r * sin( t ) ) );
+	}
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	convex_hull( &pts[0], COUNT, hull, 1 );
+	double serial_ms = elapsed( start );
+	start = chrono::steady_clock::now();
+	convex_hull( &pts[0], COUNT, parallel, THREADS );
+	double parallel_ms = elapsed( start );
+	bool ok = same( hull, parallel ) && check_hull( vector< Pt >( pts.begin(), pts.begin() + 20000 ), hull );
+	cout << "convex hull of " << COUNT << " points: " << hull.size() << " vertices, serial " << serial_ms << " ms, " << THREADS << " threads " << parallel_ms << " ms\n";
+
+	// 近乎共线：在一条斜线上取点再加极小扰动
+	pts.clear();
+	for( int i=0; i<2000; ++i ) {
+		double t = random_unit();
+		pts.push_back( Pt( 0.1 + t * 0.7, 0.3 + t * 0.9 + ( rand() % 3 - 1 ) * 1e-17 ) );
+	}
+	convex_hull( &pts[0], (int)pts.size(), hull );
+	ok = ok && ( hull.size() == 2 || check_hull( pts, hull ) );
+
+	// 完全共线、重复点与退化输入
+	pts.clear();
+	for( int i=0; i<10; ++i ) {
+		pts.push_back( Pt( i, 2 * i ) );
+		pts.push_back( Pt( i, 2 * i ) );
+	}
+	convex_hull( &pts[0], (int)pts.size(), hull );
+	ok = ok && hull.size() == 2 && hull[0].eql( 0, 0 ) && hull[1].eql( 9, 18 );
+	convex_hull( &pts[0], 2, hull );
+	ok = ok && hull.size() == 1;
+	convex_hull( &pts[0], 0, hull );
+	ok = ok && hull.empty();
+	return ok;
+}
+
+bool test_closest_pair() {
+	bool ok = true;
+	vector< Pt > pts;
+	for( int i=0; i<3000; ++i ) {
+		pts.push_back( Pt( random_unit(), random_unit() ) );
+	}
+	double expect = 1e300;
+	for( size_t i=0; i<pts.size(); ++i ) {
+		for( size_t j=i+1; j<pts.size(); ++j ) {
+			expect = min( expect, Pt::Euclid_dist_sqr( pts[i], pts[j] ) );
+		}
+	}
+	ClosestPairResult got = closest_pair( &pts[0], (int)pts.size() );
+	ok = ok && got.dist_sqr == expect && Pt::Euclid_dist_sqr( pts[got.first], pts[got.second] ) == expect && got.first < got.second;
+
+	pts.push_back( pts[1234] );
+	got = closest_pair( &pts[0], (int)pts.size() );
+	ok = ok && got.dist_sqr == 0 && got.first == 1234 && got.second == 3000;
+	ok = ok && closest_pair( &pts[0], 1 ).first == -1;
+
+	int const COUNT = 1000000;
+	pts.clear();
+	for( int i=0; i<COUNT; ++i ) {
+		pts.push_back( Pt( random_unit() * 1000, random_unit() * 1000 ) );
+	}
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	ClosestPairResult serial = closest_pair( &pts[0], COUNT, 1 );
+	double serial_ms = elapsed( start );
+	start = chrono::steady_clock::now();
+	ClosestPairResult parallel = closest_pair( &pts[0], COUNT, THREADS );
+	double parallel_ms = elapsed( start );
+	ok = ok && serial.dist_sqr == parallel.dist_sqr;
+	cout << "closest pair of " << COUNT << " points: serial " << serial_ms << " ms, " << THREADS << " threads " << parallel_ms << " ms\n";
+	return ok;
+}
+
+bool close( double a, double b, double tol ) {
+	return fabs( a - b ) <= tol;
+}
+
+bool test_polygon() {
+	bool ok = true;
+	Pt const square[] = { Pt( 0, 0 ), Pt( 1, 0 ), Pt( 1, 1 ), Pt( 0, 1 ) };
+	Pt const square_cw[] = { Pt( 0, 0 ), Pt( 0, 1 ), Pt( 1, 1 ), Pt( 1, 0 ) };
+	ok = ok && polygon_area( square, 4 ) == 1.0 && polygon_area( square_cw, 4 ) == -1.0;
+	Pt const ell[] = { Pt( 0, 0 ), Pt( 2, 0 ), Pt( 2, 1 ), Pt( 1, 1 ), Pt( 1, 2 ), Pt( 0, 2 ) };
+	Pt c = polygon_centroid( ell, 6 );
+	ok = ok && polygon_area( ell, 6 ) == 3.0 && close( c.x, 5.0 / 6, 1e-15 ) && close( c.y, 5.0 / 6, 1e-15 );
+
+	// 正多边形：面积接近 pi，重心在圆心
+	int const VERTICES = 2000000;
+	vector< Pt > poly;
+	for( int i=0; i<VERTICES; ++i ) {
+		poly.push_back( Pt( 5 + cos( 2 * PI * i / VERTICES ), 7 + sin( 2 * PI * i / VERTICES ) ) );
+	}
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	double serial = polygon_area( &poly[0], VERTICES, 1 );
+	double serial_ms = elapsed( start );
+	start = chrono::steady_clock::now();
+	double parallel = polygon_area( &poly[0], VERTICES, THREADS );
+	double parallel_ms = elapsed( start );
+	c = polygon_centroid( &poly[0], VERTICES );
+	ok = ok && close( serial, PI, 1e-9 ) && close( serial, parallel, 1e-12 ) && close( c.x, 5, 1e-12 ) && close( c.y, 7, 1e-12 );
+	cout << "area of a " << VERTICES << "-gon: serial " << serial_ms << " ms, " << THREADS << " threads " << parallel_ms << " ms\n";
+
+	// 批量点在多边形内判断
+	int const SIDES = 1000, QUERIES = 100000;
+	poly.clear();
+	for( int i=0; i<SIDES; ++i ) {
+		poly.push_back( Pt( cos( 2 * PI * i / SIDES ), sin( 2 * PI * i / SIDES ) ) );
+	}
+	vector< Pt > qs;
+	for( int i=0; i<QUERIES; ++i ) {
+		qs.push_back( Pt( random_unit() * 3 - 1.5, random_unit() * 3 - 1.5 ) );
+	}
+	vector< char > inside( QUERIES ), inside_parallel( QUERIES );
+	start = chrono::steady_clock::now();
+	points_in_polygon( &poly[0], SIDES, &qs[0], QUERIES, &inside[0], 1 );
+	serial_ms = elapsed( start );
+	start = chrono::steady_clock::now();
+	points_in_polygon( &poly[0], SIDES, &qs[0], QUERIES, &inside_parallel[0], THREADS );
+	parallel_ms = elapsed( start );
+	ok = ok && inside == inside_parallel;
+	for( int i=0; i<QUERIES; ++i ) {
+		double r = sqrt( qs[i].x * qs[i].x + qs[i].y * qs[i].y );
+		if ( r < 0.9999 || r > 1.0 ) {
+			ok = ok && ( inside[i] != 0 ) == ( r < 1.0 );
+		}
+	}
+	// 整数坐标的多边形与查询点
+	XYPair< int > const tri[] = { XYPair< int >( 0, 0 ), XYPair< int >( 10, 0 ), XYPair< int >( 0, 10 ) };
+	ok = ok && point_in_polygon( tri, 3, XYPair< int >( 2, 2 ) ) && !point_in_polygon( tri, 3, XYPair< int >( 6, 6 ) );
+	cout << QUERIES << " point-in-polygon queries against a " << SIDES << "-gon: serial " << serial_ms << " ms, " << THREADS << " threads " << parallel_ms << " ms\n";
+	return ok;
+}
+
+void test_Geometry() {
+	bool ok = test_orient2d();
+	ok = test_convex_hull() && ok;
+	ok = test_closest_pair() && ok;
+	ok = test_polygon() && ok;
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_Geometry();
+	return 0;
+}
@@ -0,0 +1,129 @@
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <memory/MemPool.hpp>
+#include <memory/LockFreeMemPool.hpp>
+#include <memory/ThreadCachedMemPool.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const ITEM_SIZE = 32;
+int const SLOTS     = 1024;
+int const OPS       = 200000;
+
+/*
+ *  给 MemPool 加一把全局锁，作为对照组
+ */
+class LockedMemPool : public MemPoolBase {
+public:
+	LockedMemPool() : m_mutex(), m_pool() { }
+
+	virtual int item_size() const {
+		return m_pool.item_size();
+	}
+
+	virtual void * alloc() {
+		lock_guard< mutex > lock( m_mutex );
+		return m_pool.alloc();
+	}
+
+	virtual void free( void * mem ) {
+		lock_guard< mutex > lock( m_mutex );
+		m_pool.free( mem );
+	}
+
+	virtual void track() {
+		lock_guard< mutex > lock( m_mutex );
+		m_pool.track();
+	}
+
+private:
+	mutex                m_mutex;
+	MemPool< ITEM_SIZE > m_pool;
+};
+
+/*
+ *  每个线程分配一项、写入自己的编号，再与共享槽位中的旧项交换并释放旧项，
+ *  因此绝大多数释放发生在另一个线程上
+ */
+bool hammer( MemPoolBase & pool, atomic< void * > * slots, int id ) {
+	bool ok = true;
+	unsigned seed = id * 2654435761u + 1;
+	for( int i=0; i<OPS; ++i ) {
+		unsigned char * mem = (unsigned char *)pool.alloc();
+		memset( mem, id, ITEM_SIZE );
+		seed = seed * 1103515245u + 12345u;
+		void * old = slots[ ( seed >> 8 ) % SLOTS ].exchange( mem, memory_order_acq_rel );
+		if ( old != BR_NULLPTR ) {
+			unsigned char * bytes = (unsigned char *)old;
+			for( int j=1; j<ITEM_SIZE; ++j ) {
+				if ( bytes[j] != bytes[0] ) {
+					ok = false;
+				}
+			}
+			pool.free( old );
+		}
+	}
+	return ok;
+}
+
+double run( MemPoolBase & pool, int threads, bool & ok ) {
+	vector< atomic< void * > > slots( SLOTS );
+	for( int i=0; i<SLOTS; ++i ) {
+		slots[i].store( BR_NULLPTR );
+	}
+	vector< thread > workers;
+	vector< char > results( threads, 1 );
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int t=0; t<threads; ++t ) {
+		workers.push_back( thread( [&, t]() { results[t] = hammer( pool, &slots[0], t ); } ) );
+	}
+	for( int t=0; t<threads; ++t ) {
+		workers[t].join();
+	}
+	double secs = chrono::duration< double >( chrono::steady_clock::now() - start ).count();
+	for( int i=0; i<SLOTS; ++i ) {
+		pool.free( slots[i].load() );
+	}
+	for( int t=0; t<threads; ++t ) {
+		ok = ok && results[t];
+	}
+	// 每次迭代包含一次分配与一次释放
+	return 2.0 * OPS * threads / secs;
+}
+
+void test_LockFreeMemPool() {
+	int max_threads = thread::hardware_concurrency();
+	if ( max_threads < 4 ) {
+		max_threads = 4;
+	}
+	bool ok = true;
+
+	cout << "threads  locked(Mops/s)  lock-free(Mops/s)  thread-cached(Mops/s)\n";
+	for( int threads=1; threads<=max_threads; threads*=2 ) {
+		LockedMemPool locked;
+		LockFreeMemPool< ITEM_SIZE > lock_free;
+		ThreadCachedMemPool< ITEM_SIZE > cached;
+
+		double r0 = run( locked, threads, ok );
+		double r1 = run( lock_free, threads, ok );
+		double r2 = run( cached, threads, ok );
+		if ( lock_free.curr_alloc() != 0 || cached.curr_alloc() != 0 ) {
+			ok = false;
+		}
+		cout << threads << "\t " << r0 / 1e6 << "\t\t" << r1 / 1e6 << "\t\t" << r2 / 1e6 << "\n";
+	}
+
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_LockFreeMemPool();
+	return 0;
+}
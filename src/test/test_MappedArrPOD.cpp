@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <structure/MappedArrPOD.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const COUNT = 1 << 20;
+
+char PATH[] = "/tmp/test_MappedArrPOD.XXXXXX";
+
+struct Record {
+	int    id;
+	float  x, y;
+	double weight;
+};
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+template< class Arr >
+bool open_throws( std::uint32_t version ) {
+	try {
+		Arr arr( PATH, version );
+	} catch( std::runtime_error const & ) {
+		return true;
+	}
+	return false;
+}
+
+void test_MappedArrPOD() {
+	// mkstemp 建出的空文件由 MappedArrPOD 初始化
+	int fd = mkstemp( PATH );
+	if ( fd < 0 ) {
+		cout << "mkstemp failed\nFAIL\n";
+		return;
+	}
+	close( fd );
+	bool ok = true;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	{
+		MappedArrPOD< Record, 16 > arr( PATH, 7 );
+		ok = ok && arr.empty() && arr.capacity() == 16;
+		for( int i=0; i<COUNT; ++i ) {
+			Record r = { i, i * 0.5f, i * 2.0f, i * 0.25 };
+			arr.push_back( r );
+		}
+		ok = ok && arr.size() == COUNT && arr.capacity() >= COUNT;
+	}
+	cout << "push_back " << COUNT << " records: " << elapsed( start ) << " ms\n";
+
+	// 重新打开只需映射，不必逐个读回
+	start = chrono::steady_clock::now();
+	{
+		MappedArrPOD< Record, 16 > arr( PATH, 7 );
+		cout << "reopen: " << elapsed( start ) << " ms\n";
+		ok = ok && arr.size() == COUNT && arr.version() == 7;
+		ok = ok && arr[0].id == 0 && arr[COUNT-1].id == COUNT-1 && arr[12345].weight == 12345 * 0.25;
+		ok = ok && arr.pop_back().id == COUNT-1;
+	}
+	{
+		MappedArrPOD< Record, 16 > arr( PATH, 7 );
+		ok = ok && arr.size() == COUNT-1;
+	}
+
+	// 文件头校验
+	ok = ok && open_throws< MappedArrPOD< Record, 16 > >( 8 );
+	ok = ok && open_throws< MappedArrPOD< int, 16 > >( 7 );
+
+	remove( PATH );
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_MappedArrPOD();
+	return 0;
+}
@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <memory/MemPool.hpp>
+#include <memory/LockFreeMemPool.hpp>
+#include <memory/ThreadCachedMemPool.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const BURST  = 5000;
+int const ROUNDS = 400;
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+/*
+ *  每轮突发分配 BURST 项再全部释放，分别用逐项调用与批量接口
+ */
+bool bench( char const * name, MemPoolBase & loop_pool, MemPoolBase & batch_pool ) {
+	vector< void * > items( BURST );
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		for( int i=0; i<BURST; ++i ) {
+			items[i] = loop_pool.alloc();
+		}
+		for( int i=0; i<BURST; ++i ) {
+			loop_pool.free( items[i] );
+		}
+	}
+	double loop_ms = elapsed( start );
+
+	start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		batch_pool.alloc_n( &items[0], BURST );
+		batch_pool.free_n( &items[0], BURST );
+	}
+	double batch_ms = elapsed( start );
+
+	// 批量分配出的项必须互不相同
+	batch_pool.alloc_n( &items[0], BURST );
+	vector< void * > sorted( items );
+	sort( sorted.begin(), sorted.end() );
+	bool ok = adjacent_find( sorted.begin(), sorted.end() ) == sorted.end();
+	batch_pool.free_n( &items[0], BURST );
+
+	cout << name << ": loop " << loop_ms << " ms, batch " << batch_ms << " ms\n";
+	return ok;
+}
+
+/*
+ *  每块不超过策略给定的字节数（除非 MIN_COUNT 要求更大的块），并且块内每一项都可写
+ */
+template< class Pool, class Policy, int SIZE >
+bool check_block( char const * name ) {
+	Pool pool;
+	vector< void * > items( Pool::COUNT + 1 );
+	pool.alloc_n( &items[0], (int)items.size() );
+	for( size_t i=0; i<items.size(); ++i ) {
+		memset( items[i], (int)i, SIZE );
+	}
+	MemPoolStats stats;
+	pool.stats( stats );
+	long long block_bytes = stats.bytes_reserved / stats.blocks;
+	bool fits = (long long)Policy::BLOCK_MIN_COUNT * SIZE > Policy::BLOCK_BYTES || block_bytes <= Policy::BLOCK_BYTES;
+	bool ok = fits && stats.blocks == 2;
+	for( size_t i=0; i<items.size(); ++i ) {
+		ok = ok && *( (unsigned char *)items[i] + SIZE - 1 ) == (unsigned char)i;
+	}
+	pool.free_n( &items[0], (int)items.size() );
+	if ( !ok ) {
+		cout << name << "<" << SIZE << ">: block of " << block_bytes << " bytes for policy of " << Policy::BLOCK_BYTES << "\n";
+	}
+	return ok;
+}
+
+template< class Policy >
+bool check_policy() {
+	bool ok = check_block< MemPool< 20, Policy >, Policy, 20 >( "MemPool" );
+	ok = check_block< MemPool< 64, Policy >, Policy, 64 >( "MemPool" ) && ok;
+	ok = check_block< MemPool< 4096, Policy >, Policy, 4096 >( "MemPool" ) && ok;
+	ok = check_block< LockFreeMemPool< 3, Policy >, Policy, 3 >( "LockFreeMemPool" ) && ok;
+	ok = check_block< LockFreeMemPool< 20, Policy >, Policy, 20 >( "LockFreeMemPool" ) && ok;
+	ok = check_block< LockFreeMemPool< 64, Policy >, Policy, 64 >( "LockFreeMemPool" ) && ok;
+	return ok;
+}
+
+/*
+ *  trim(keep) 至少保留 keep 个空闲项，shrink_to_fit 放掉所有空块，
+ *  每块还有一项在用时一块也不能放
+ */
+bool check_trim() {
+	typedef MemPool< 64 > Pool;
+	int const COUNT = Pool::COUNT;
+	Pool pool;
+	vector< void * > items( 10 * COUNT );
+	for( size_t i=0; i<items.size(); ++i ) {
+		items[i] = pool.alloc();
+	}
+	// 每块留下第一项
+	for( size_t i=0; i<items.size(); ++i ) {
+		if ( i % COUNT != 0 ) {
+			pool.free( items[i] );
+		}
+	}
+	bool ok = pool.trim() == 0 && pool.blocks() == 10;
+	for( size_t i=0; i<items.size(); i+=COUNT ) {
+		pool.free( items[i] );
+	}
+	ok = ok && pool.trim( COUNT + 1 ) == 8 && pool.blocks() == 2;
+	ok = ok && pool.shrink_to_fit() == 2 && pool.blocks() == 0;
+	// 放掉块后的空闲链表仍然可用
+	for( size_t i=0; i<items.size(); ++i ) {
+		items[i] = pool.alloc();
+		memset( items[i], 0, 64 );
+	}
+	pool.free_n( &items[0], (int)items.size() );
+	ok = ok && pool.curr_alloc() == 0 && pool.shrink_to_fit() == 10;
+	if ( !ok ) {
+		cout << "trim: FAIL\n";
+	}
+	return ok;
+}
+
+/*
+ *  自动回收：整块空出时及时放掉；空闲项分散在各块时不能每次 free 都遍历空闲链表
+ */
+bool check_auto_trim() {
+	typedef MemPool< 64 > Pool;
+	int const COUNT = Pool::COUNT;
+	int const BLOCKS = 2000;
+	bool ok = true;
+	{
+		Pool pool;
+		pool.set_auto_trim( 4 * COUNT, COUNT );
+		vector< void * > items( 20 * COUNT );
+		for( size_t i=0; i<items.size(); ++i ) {
+			items[i] = pool.alloc();
+		}
+		for( size_t i=0; i<items.size(); ++i ) {
+			pool.free( items[i] );
+		}
+		ok = pool.blocks() <= 5;
+	}
+
+	vector< void * > items( BLOCKS * COUNT );
+	double ms[2];
+	for( int with_trim=0; with_trim<2; ++with_trim ) {
+		Pool pool;
+		if ( with_trim ) {
+			pool.set_auto_trim( 4 * COUNT, COUNT );
+		}
+		for( size_t i=0; i<items.size(); ++i ) {
+			items[i] = pool.alloc();
+		}
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for( size_t i=0; i<items.size(); ++i ) {
+			if ( i % COUNT != 0 ) {
+				pool.free( items[i] );
+			}
+		}
+		ms[with_trim] = elapsed( start );
+		ok = ok && pool.blocks() == BLOCKS;
+		for( size_t i=0; i<items.size(); i+=COUNT ) {
+			pool.free( items[i] );
+		}
+		pool.shrink_to_fit();
+		ok = ok && pool.blocks() == 0;
+	}
+	cout << "fragmented free of " << BLOCKS * COUNT << " items: no auto-trim " << ms[0] << " ms, auto-trim " << ms[1] << " ms\n";
+	// 没有滞回时每次 free 都遍历整个空闲链表，耗时按平方增长
+	ok = ok && ms[1] < 20 * ms[0] + 50;
+	if ( !ok ) {
+		cout << "auto-trim: FAIL\n";
+	}
+	return ok;
+}
+
+void print_stats( char const * name, MemPoolStats const & stats, void * ) {
+	write_json( cout, stats, name ) << "\n";
+}
+
+void test_MemPool() {
+	// 没有预留大页时 HugePageBlockPolicy 退回普通映射，同样要通过
+	bool ok = check_policy< HeapBlockPolicy<> >();
+	ok = check_policy< HugePageBlockPolicy<> >() && ok;
+	ok = check_trim() && ok;
+	ok = check_auto_trim() && ok;
+	{
+		MemPool< 48 > loop_pool, batch_pool;
+		batch_pool.set_sample_period( 1000 );
+		ok = bench( "MemPool<48>", loop_pool, batch_pool ) && ok;
+		ok = ok && batch_pool.curr_alloc() == 0;
+		batch_pool.report( "MemPool<48>", print_stats, BR_NULLPTR );
+	}
+	{
+		LockFreeMemPool< 48 > loop_pool, batch_pool;
+		ok = bench( "LockFreeMemPool<48>", loop_pool, batch_pool ) && ok;
+		ok = ok && batch_pool.curr_alloc() == 0;
+	}
+	{
+		ThreadCachedMemPool< 48 > loop_pool, batch_pool;
+		ok = bench( "ThreadCachedMemPool<48>", loop_pool, batch_pool ) && ok;
+		ok = ok && batch_pool.curr_alloc() == 0;
+		loop_pool.report( "ThreadCachedMemPool<48>", print_stats, BR_NULLPTR );
+	}
+	{
+		// free_n 中的空指针不计入释放次数
+		ThreadCachedMemPool< 48 > pool;
+		void * items[200] = { };
+		pool.alloc_n( items, 100 );
+		pool.free_n( items, 200 );
+		MemPoolStats stats;
+		pool.stats( stats );
+		ok = ok && stats.threads.size() == 1 && stats.threads[0].allocs == 100 && stats.threads[0].frees == 100;
+	}
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_MemPool();
+	return 0;
+}
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <memory/ObjectPool.hpp>
+
+using namespace std;
+using namespace BR;
+
+/*
+ *  记录构造与析构次数的对象
+ */
+struct Tracked {
+	static int constructed;
+	static int destroyed;
+
+	Tracked( int v, string const & n ) : value( v ), name( n ) {
+		if ( v < 0 ) {
+			throw runtime_error( "negative" );
+		}
+		++constructed;
+	}
+
+	~Tracked() {
+		++destroyed;
+	}
+
+	int     value;
+	string  name;
+};
+
+int Tracked::constructed = 0;
+int Tracked::destroyed = 0;
+
+bool counts( int constructed, int destroyed ) {
+	return Tracked::constructed == constructed && Tracked::destroyed == destroyed;
+}
+
+void test_ObjectPool() {
+	bool ok = true;
+	{
+		ObjectPool< Tracked > pool;
+
+		// create/destroy 调用构造与析构函数，参数原样转发
+		Tracked * a = pool.create( 1, string( "a" ) );
+		ok = ok && a->value == 1 && a->name == "a" && counts( 1, 0 ) && pool.size() == 1;
+		pool.destroy( a );
+		ok = ok && counts( 1, 1 ) && pool.size() == 0;
+
+		// 析构后内存被下一次 create 复用
+		Tracked * b = pool.create( 2, string( "b" ) );
+		ok = ok && b == a && b->name == "b";
+
+		// 构造函数抛出异常时内存退回池中
+		try {
+			pool.create( -1, string( "bad" ) );
+			ok = false;
+		} catch( runtime_error const & ) {
+		}
+		ok = ok && counts( 2, 1 ) && pool.size() == 1;
+
+		// unique_ptr 离开作用域时经删除器析构
+		{
+			ObjectPool< Tracked >::UniquePtr u = pool.create_unique( 3, string( "u" ) );
+			ok = ok && u->value == 3 && pool.size() == 2;
+		}
+		ok = ok && counts( 3, 2 ) && pool.size() == 1;
+
+		// release 回收而不析构，acquire 取回同一个对象而不构造
+		Tracked * c = pool.create( 4, string( "c" ) );
+		c->name = "kept";
+		pool.release( c );
+		ok = ok && counts( 4, 2 ) && pool.recycled() == 1 && pool.size() == 1;
+		Tracked * d = pool.acquire( 5, string( "ignored" ) );
+		ok = ok && d == c && d->value == 4 && d->name == "kept" && counts( 4, 2 ) && pool.recycled() == 0;
+
+		// 回收栈为空时 acquire 构造新对象
+		Tracked * e = pool.acquire( 6, string( "e" ) );
+		ok = ok && e != d && e->value == 6 && counts( 5, 2 );
+
+		// purge 析构回收栈中的对象
+		pool.release( d );
+		pool.release( e );
+		pool.purge();
+		ok = ok && counts( 5, 4 ) && pool.recycled() == 0 && pool.size() == 1;
+
+		// 离开作用域时：回收栈中的对象被析构，仍在使用的 b 不被析构
+		pool.release( pool.create( 7, string( "r" ) ) );
+		ok = ok && counts( 6, 4 ) && pool.size() == 1 && pool.recycled() == 1;
+	}
+	ok = ok && counts( 6, 5 );
+
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_ObjectPool();
+	return 0;
+}
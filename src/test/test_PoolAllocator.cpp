@@ -0,0 +1,84 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include <memory/PoolAllocator.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const KEYS   = 100000;
+int const ROUNDS = 20;
+
+struct Tree {
+	Tree() : value( 0 ), children() { }
+
+	int                                  value;
+	list< Tree, PoolAllocator< Tree > >  children;
+};
+
+/*
+ *  每轮插入 KEYS 个伪随机键，再按相同顺序全部删除
+ */
+template< class Map >
+double bench_map( long long & checksum ) {
+	Map m;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		unsigned seed = r + 1;
+		for( int i=0; i<KEYS; ++i ) {
+			seed = seed * 1103515245u + 12345u;
+			m[ (int)( seed >> 4 ) ] = i;
+		}
+		checksum += (long long)m.size();
+		seed = r + 1;
+		for( int i=0; i<KEYS; ++i ) {
+			seed = seed * 1103515245u + 12345u;
+			m.erase( (int)( seed >> 4 ) );
+		}
+	}
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+void test_PoolAllocator() {
+	typedef map< int, int, less< int >, PoolAllocator< pair< int const, int > > > PoolMap;
+	typedef unordered_map< int, int, hash< int >, equal_to< int >,
+		PoolAllocator< pair< int const, int > > > PoolHashMap;
+
+	long long sum_std = 0, sum_pool = 0;
+	double std_ms = bench_map< map< int, int > >( sum_std );
+	double pool_ms = bench_map< PoolMap >( sum_pool );
+	cout << "std::map insert/erase: std::allocator " << std_ms << " ms, PoolAllocator " << pool_ms << " ms\n";
+
+	long long hsum_std = 0, hsum_pool = 0;
+	double hstd_ms = bench_map< unordered_map< int, int > >( hsum_std );
+	double hpool_ms = bench_map< PoolHashMap >( hsum_pool );
+	cout << "std::unordered_map insert/erase: std::allocator " << hstd_ms << " ms, PoolAllocator " << hpool_ms << " ms\n";
+
+	Tree root;
+	for( int i=0; i<100; ++i ) {
+		root.children.push_back( Tree() );
+		root.children.back().value = i;
+	}
+
+	// int 与 float 取整后尺寸相同，共用同一个池：刚释放的项立即被另一类型复用
+	PoolAllocator< int > int_alloc;
+	PoolAllocator< float > float_alloc;
+	int * i = int_alloc.allocate( 1 );
+	int_alloc.deallocate( i, 1 );
+	float * f = float_alloc.allocate( 1 );
+	bool shared = (void *)i == (void *)f;
+	float_alloc.deallocate( f, 1 );
+
+	bool ok = sum_std == sum_pool && hsum_std == hsum_pool && root.children.size() == 100 && shared;
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_PoolAllocator();
+	return 0;
+}
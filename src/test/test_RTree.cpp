@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <math/AABB2D.hpp>
+#include <spatial/RTree.hpp>
+
+using namespace std;
+using namespace BR;
+
+typedef AABB2D< double > Box;
+typedef XYPair< double > Corner;
+
+int const COUNT   = 200000;
+int const QUERIES = 4000;
+
+// 单核机器上也要走并行路径，线程数至少取 4
+int const THREADS = max( 4, (int)thread::hardware_concurrency() );
+
+double const WORLD = 10000.0;
+double const SPAN  = 40.0;
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+double random_coord( double range ) {
+	return rand() / ( RAND_MAX + 1.0 ) * range;
+}
+
+Box random_box( double span ) {
+	double x = random_coord( WORLD ), y = random_coord( WORLD );
+	return Box( Corner( x, y ), Corner( x + random_coord( span ), y + random_coord( span ) ) );
+}
+
+void sort_all( vector< vector< int > > & results ) {
+	for( size_t i=0; i<results.size(); ++i ) {
+		sort( results[i].begin(), results[i].end() );
+	}
+}
+
+void test_RTree() {
+	vector< Box > boxes, qs;
+	for( int i=0; i<COUNT; ++i ) {
+		boxes.push_back( random_box( SPAN ) );
+	}
+	for( int i=0; i<QUERIES; ++i ) {
+		qs.push_back( random_box( SPAN * 4 ) );
+	}
+	bool ok = true;
+
+	// 暴力扫描作为正确答案
+	vector< vector< int > > expect( QUERIES ), got;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int q=0; q<QUERIES; ++q ) {
+		for( int i=0; i<COUNT; ++i ) {
+			if ( overlaps( boxes[i], qs[q] ) ) {
+				expect[q].push_back( i );
+			}
+		}
+	}
+	double brute_ms = elapsed( start );
+
+	start = chrono::steady_clock::now();
+	RTree< double > serial;
+	serial.build( &boxes[0], COUNT, 1 );
+	double serial_build = elapsed( start );
+
+	start = chrono::steady_clock::now();
+	RTree< double > tree;
+	tree.build( &boxes[0], COUNT, THREADS );
+	double parallel_build = elapsed( start );
+	ok = ok && tree.size() == COUNT;
+
+	got.assign( QUERIES, vector< int >() );
+	start = chrono::steady_clock::now();
+	for( int q=0; q<QUERIES; ++q ) {
+		serial.query( qs[q], got[q] );
+	}
+	double serial_ms = elapsed( start );
+	sort_all( got );
+	ok = ok && got == expect;
+
+	start = chrono::steady_clock::now();
+	tree.query_batch( &qs[0], QUERIES, got, THREADS );
+	double batch_ms = elapsed( start );
+	sort_all( got );
+	ok = ok && got == expect;
+
+	// 边界情况：空树、单个盒子、边界相接
+	RTree< int, 4 > small;
+	small.build( BR_NULLPTR, 0 );
+	vector< int > out;
+	small.query( AABB2D< int >( XYPair< int >( 0, 0 ), XYPair< int >( 10, 10 ) ), out );
+	ok = ok && out.empty() && small.size() == 0;
+	AABB2D< int > one( XYPair< int >( 5, 5 ), XYPair< int >( 2, 3 ) );
+	small.build( &one, 1 );
+	small.query( AABB2D< int >( XYPair< int >( 0, 0 ), XYPair< int >( 2, 3 ) ), out );
+	ok = ok && out.size() == 1 && out[0] == 0;
+	out.clear();
+	small.query( AABB2D< int >( XYPair< int >( 6, 0 ), XYPair< int >( 9, 9 ) ), out );
+	ok = ok && out.empty();
+
+	cout << QUERIES << " overlap queries over " << COUNT << " boxes, " << THREADS << " threads\n";
+	cout << "brute force " << brute_ms << " ms\n";
+	cout << "build       serial " << serial_build << " ms, parallel " << parallel_build << " ms\n";
+	cout << "query       serial " << serial_ms << " ms, batch " << batch_ms << " ms\n";
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_RTree();
+	return 0;
+}
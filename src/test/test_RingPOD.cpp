@@ -0,0 +1,185 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <structure/RingPOD.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const CAPACITY   = 1024;
+int const ITEMS      = 1 << 22;
+int const BATCH      = 32;
+int const ROUNDTRIPS = 100000;
+
+template< int BYTES >
+struct Payload {
+	long long seq;
+	char      fill[BYTES - sizeof(long long)];
+};
+
+double seconds( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double >( chrono::steady_clock::now() - start ).count();
+}
+
+/*
+ *  生产者按序号压入 ITEMS 个元素，消费者检查序号是否连续；返回每秒传递的元素数
+ */
+template< class Tp >
+double spsc_throughput( int batch, bool & ok ) {
+	unique_ptr< SpscRingPOD< Tp, CAPACITY > > ring( new SpscRingPOD< Tp, CAPACITY >() );
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	thread producer( [&]() {
+		vector< Tp > buf( batch );
+		for( int i=0; i<ITEMS; ) {
+			int n = ITEMS - i < batch ? ITEMS - i : batch;
+			for( int j=0; j<n; ++j ) {
+				buf[j].seq = i + j;
+			}
+			int sent = 0;
+			while ( sent < n ) {
+				int pushed = batch == 1 ? ( ring->try_push( buf[0] ) ? 1 : 0 ) : ring->push_n( &buf[sent], n - sent );
+				if ( pushed == 0 ) {
+					this_thread::yield();
+				}
+				sent += pushed;
+			}
+			i += n;
+		}
+	} );
+	vector< Tp > buf( batch );
+	long long expect = 0;
+	while ( expect < ITEMS ) {
+		int n = batch == 1 ? ( ring->try_pop( buf[0] ) ? 1 : 0 ) : ring->pop_n( &buf[0], batch );
+		if ( n == 0 ) {
+			this_thread::yield();
+		}
+		for( int j=0; j<n; ++j ) {
+			ok = ok && buf[j].seq == expect++;
+		}
+	}
+	producer.join();
+	return ITEMS / seconds( start );
+}
+
+/*
+ *  两个队列之间来回传递一个元素，返回单程平均延迟（纳秒）
+ */
+template< class Tp >
+double spsc_latency() {
+	unique_ptr< SpscRingPOD< Tp, CAPACITY > > ping( new SpscRingPOD< Tp, CAPACITY >() );
+	unique_ptr< SpscRingPOD< Tp, CAPACITY > > pong( new SpscRingPOD< Tp, CAPACITY >() );
+	thread echo( [&]() {
+		Tp t;
+		for( int i=0; i<ROUNDTRIPS; ++i ) {
+			while ( !ping->try_pop( t ) ) {
+				this_thread::yield();
+			}
+			while ( !pong->try_push( t ) ) {
+				this_thread::yield();
+			}
+		}
+	} );
+	Tp t = Tp();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int i=0; i<ROUNDTRIPS; ++i ) {
+		while ( !ping->try_push( t ) ) {
+			this_thread::yield();
+		}
+		while ( !pong->try_pop( t ) ) {
+			this_thread::yield();
+		}
+	}
+	double secs = seconds( start );
+	echo.join();
+	return secs * 1e9 / ROUNDTRIPS / 2;
+}
+
+/*
+ *  threads 个生产者与 threads 个消费者，检查弹出的序号之和；返回每秒传递的元素数
+ */
+template< class Tp >
+double mpmc_throughput( int threads, bool & ok ) {
+	unique_ptr< MpmcRingPOD< Tp, CAPACITY > > ring( new MpmcRingPOD< Tp, CAPACITY >() );
+	int per_thread = ITEMS / 4 / threads;
+	atomic< long long > sum( 0 );
+	vector< thread > workers;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int t=0; t<threads; ++t ) {
+		workers.push_back( thread( [&, t]() {
+			Tp item = Tp();
+			for( int i=0; i<per_thread; ++i ) {
+				item.seq = (long long)t * per_thread + i;
+				while ( !ring->try_push( item ) ) {
+					this_thread::yield();
+				}
+			}
+		} ) );
+		workers.push_back( thread( [&]() {
+			Tp item;
+			long long local = 0;
+			for( int i=0; i<per_thread; ++i ) {
+				while ( !ring->try_pop( item ) ) {
+					this_thread::yield();
+				}
+				local += item.seq;
+			}
+			sum += local;
+		} ) );
+	}
+	for( size_t i=0; i<workers.size(); ++i ) {
+		workers[i].join();
+	}
+	double secs = seconds( start );
+	long long total = (long long)threads * per_thread;
+	ok = ok && sum.load() == total * ( total - 1 ) / 2 && ring->empty();
+	return total / secs;
+}
+
+template< int BYTES >
+void bench_payload( int max_threads, bool & ok ) {
+	typedef Payload< BYTES > Tp;
+	double single = spsc_throughput< Tp >( 1, ok );
+	double batched = spsc_throughput< Tp >( BATCH, ok );
+	double latency = spsc_latency< Tp >();
+	cout << BYTES << "\t spsc " << single / 1e6 << " Mops/s, batch " << batched / 1e6 << " Mops/s, latency " << latency << " ns\n";
+	cout << "\t mpmc";
+	for( int threads=1; threads<=max_threads; threads*=2 ) {
+		cout << " " << threads << "x" << threads << ": " << mpmc_throughput< Tp >( threads, ok ) / 1e6 << " Mops/s";
+	}
+	cout << "\n";
+}
+
+void test_RingPOD() {
+	bool ok = true;
+
+	// 单线程边界：满、空、批量绕回
+	SpscRingPOD< int, 8 > spsc;
+	int in[8] = { 0, 1, 2, 3, 4, 5, 6, 7 }, out[8];
+	ok = ok && spsc.push_n( in, 5 ) == 5 && spsc.pop_n( out, 3 ) == 3 && out[2] == 2;
+	ok = ok && spsc.push_n( in, 8 ) == 6 && spsc.size() == 8 && !spsc.try_push( 9 );
+	ok = ok && spsc.pop_n( out, 8 ) == 8 && out[0] == 3 && out[2] == 0 && out[7] == 5 && spsc.empty();
+
+	MpmcRingPOD< int, 4 > mpmc;
+	ok = ok && mpmc.push_n( in, 8 ) == 4 && !mpmc.try_push( 9 ) && mpmc.size() == 4;
+	ok = ok && mpmc.pop_n( out, 8 ) == 4 && out[3] == 3 && mpmc.empty();
+
+	int max_threads = thread::hardware_concurrency() / 2;
+	if ( max_threads < 2 ) {
+		max_threads = 2;
+	}
+	cout << "bytes\n";
+	bench_payload< 8 >( max_threads, ok );
+	bench_payload< 64 >( max_threads, ok );
+	bench_payload< 256 >( max_threads, ok );
+
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_RingPOD();
+	return 0;
+}
@@ -0,0 +1,86 @@
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <memory/SizeClassAllocator.hpp>
+
+using namespace std;
+using namespace BR;
+
+typedef SizeClassAllocator<> Allocator;
+
+long long curr_alloc( MemPoolBase * pool ) {
+	MemPoolStats stats;
+	pool->stats( stats );
+	return stats.curr_alloc;
+}
+
+/*
+ *  各级别边界上的取整：恰好等于级别时不升级，多 1 字节升到下一级
+ */
+bool test_rounding( Allocator const & alloc ) {
+	size_t const cases[][2] = {
+		{ 0, 8 }, { 1, 8 }, { 8, 8 }, { 9, 16 }, { 16, 16 }, { 17, 24 }, { 33, 48 }, { 48, 48 },
+		{ 49, 64 }, { 97, 128 }, { 129, 160 }, { 193, 256 }, { 255, 256 }, { 256, 256 }, { 257, 257 }, { 4000, 4000 }
+	};
+	bool ok = true;
+	for( size_t i=0; i<sizeof(cases)/sizeof(cases[0]); ++i ) {
+		if ( alloc.size_class( cases[i][0] ) != cases[i][1] ) {
+			cout << "size_class(" << cases[i][0] << ") = " << alloc.size_class( cases[i][0] ) << ", expected " << cases[i][1] << "\n";
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+void test_SizeClassAllocator() {
+	Allocator alloc;
+	bool ok = test_rounding( alloc );
+
+	// 每种尺寸的结果都按 8 字节对齐，写满整个请求不会互相覆盖
+	vector< void * > mem;
+	vector< size_t > sizes;
+	for( size_t bytes=1; bytes<=300; ++bytes ) {
+		void * p = alloc.allocate( bytes );
+		ok = ok && ( (size_t)p & 7 ) == 0;
+		memset( p, (int)( bytes & 0xFF ), bytes );
+		mem.push_back( p );
+		sizes.push_back( bytes );
+	}
+	for( size_t i=0; i<mem.size(); ++i ) {
+		unsigned char const * p = (unsigned char const *)mem[i];
+		ok = ok && p[0] == ( sizes[i] & 0xFF ) && p[sizes[i]-1] == ( sizes[i] & 0xFF );
+	}
+	// 每个级别的池里正好是映射到该级别的请求数，超过最大级别的请求不进入任何池
+	long long pooled = 0;
+	for( int cls=0; cls<DefaultSizeClasses::COUNT; ++cls ) {
+		pooled += curr_alloc( alloc.pool( cls ) );
+	}
+	ok = ok && curr_alloc( alloc.pool( 0 ) ) == 8 && curr_alloc( alloc.pool( 4 ) ) == 16 && pooled == 256;
+	for( size_t i=0; i<mem.size(); ++i ) {
+		alloc.deallocate( mem[i], sizes[i] );
+	}
+	for( int cls=0; cls<DefaultSizeClasses::COUNT; ++cls ) {
+		ok = ok && curr_alloc( alloc.pool( cls ) ) == 0;
+	}
+
+	// 释放后同一级别的下一次分配复用刚释放的项，即使请求的字节数不同
+	void * a = alloc.allocate( 40 );
+	alloc.deallocate( a, 40 );
+	void * b = alloc.allocate( 33 );
+	ok = ok && a == b;
+	alloc.deallocate( b, 33 );
+
+	// 大于最大级别的请求直接走 ::operator new
+	void * big = alloc.allocate( Allocator::MAX_SIZE + 1 );
+	memset( big, 0, Allocator::MAX_SIZE + 1 );
+	ok = ok && curr_alloc( alloc.pool( DefaultSizeClasses::COUNT - 1 ) ) == 0;
+	alloc.deallocate( big, Allocator::MAX_SIZE + 1 );
+
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_SizeClassAllocator();
+	return 0;
+}
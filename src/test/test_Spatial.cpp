@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <math/Point2D.hpp>
+#include <spatial/KdTree.hpp>
+#include <spatial/UniformGrid.hpp>
+
+using namespace std;
+using namespace BR;
+
+typedef Point2D< double > Pt;
+
+int const COUNT   = 200000;
+int const QUERIES = 1000;
+int const K       = 8;
+
+double const WORLD  = 10000.0;
+double const RADIUS = 50.0;
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+double random_coord() {
+	return rand() / ( RAND_MAX + 1.0 ) * WORLD;
+}
+
+/*
+ *  暴力扫描，作为对照组与正确答案
+ */
+struct BruteForce {
+	vector< Pt > const & pts;
+
+	void knn( Pt const & q, int k, vector< int > & out ) const {
+		vector< pair< double, int > > all( pts.size() );
+		for( size_t i=0; i<pts.size(); ++i ) {
+			all[i] = make_pair( Pt::Euclid_dist_sqr( pts[i], q ), (int)i );
+		}
+		partial_sort( all.begin(), all.begin() + k, all.end() );
+		out.clear();
+		for( int i=0; i<k; ++i ) {
+			out.push_back( all[i].second );
+		}
+	}
+
+	void radius( Pt const & q, double r, vector< int > & out ) const {
+		for( size_t i=0; i<pts.size(); ++i ) {
+			if ( Pt::Euclid_dist_sqr( pts[i], q ) <= r * r ) {
+				out.push_back( (int)i );
+			}
+		}
+	}
+
+	void box( Pt const & lo, Pt const & hi, vector< int > & out ) const {
+		for( size_t i=0; i<pts.size(); ++i ) {
+			if ( pts[i].x >= lo.x && pts[i].x <= hi.x && pts[i].y >= lo.y && pts[i].y <= hi.y ) {
+				out.push_back( (int)i );
+			}
+		}
+	}
+};
+
+/*
+ *  跑完全部查询，返回耗时；每次查询的结果排序后存入 results 以便比较
+ */
+template< class Index >
+double run( Index const & index, vector< Pt > const & qs, vector< vector< int > > & results ) {
+	results.assign( qs.size() * 3, vector< int >() );
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( size_t i=0; i<qs.size(); ++i ) {
+		index.knn( qs[i], K, results[3*i] );
+		index.radius( qs[i], RADIUS, results[3*i+1] );
+		index.box( Pt( qs[i].x - RADIUS, qs[i].y - RADIUS / 2 ), Pt( qs[i].x + RADIUS, qs[i].y + RADIUS / 2 ), results[3*i+2] );
+	}
+	double ms = elapsed( start );
+	for( size_t i=0; i<results.size(); ++i ) {
+		if ( i % 3 != 0 ) {
+			sort( results[i].begin(), results[i].end() );
+		}
+	}
+	return ms;
+}
+
+void test_Spatial() {
+	vector< Pt > pts, qs;
+	for( int i=0; i<COUNT; ++i ) {
+		pts.push_back( Pt( random_coord(), random_coord() ) );
+	}
+	for( int i=0; i<QUERIES; ++i ) {
+		qs.push_back( Pt( random_coord(), random_coord() ) );
+	}
+
+	vector< vector< int > > expect, got;
+	BruteForce brute = { pts };
+	double brute_ms = run( brute, qs, expect );
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	KdTree< Pt > tree;
+	tree.build( &pts[0], COUNT );
+	double tree_build = elapsed( start );
+	double tree_ms = run( tree, qs, got );
+	bool ok = got == expect;
+
+	start = chrono::steady_clock::now();
+	UniformGrid< Pt > grid( RADIUS );
+	grid.build( &pts[0], COUNT );
+	double grid_build = elapsed( start );
+	double grid_ms = run( grid, qs, got );
+	ok = ok && got == expect;
+
+	// 移动所有点后网格仍与暴力扫描一致
+	start = chrono::steady_clock::now();
+	for( int i=0; i<COUNT; ++i ) {
+		pts[i] = Pt( pts[i].x + rand() % 201 - 100, pts[i].y + rand() % 201 - 100 );
+		grid.move( i, pts[i] );
+	}
+	double move_ms = elapsed( start );
+	run( brute, qs, expect );
+	run( grid, qs, got );
+	ok = ok && got == expect;
+
+	// 删除后再插入
+	for( int i=0; i<COUNT; i+=2 ) {
+		grid.remove( i );
+	}
+	ok = ok && grid.size() == COUNT / 2 && !grid.contains( 0 ) && grid.contains( 1 );
+	for( int i=0; i<COUNT; i+=2 ) {
+		grid.insert( i, pts[i] );
+	}
+	run( grid, qs, got );
+	ok = ok && got == expect;
+
+	cout << QUERIES << " queries (knn k=" << K << ", radius, box) over " << COUNT << " points\n";
+	cout << "brute force " << brute_ms << " ms\n";
+	cout << "k-d tree    " << tree_ms << " ms, build " << tree_build << " ms\n";
+	cout << "grid        " << grid_ms << " ms, build " << grid_build << " ms, move all " << move_ms << " ms\n";
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_Spatial();
+	return 0;
+}
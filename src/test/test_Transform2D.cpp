@@ -0,0 +1,149 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <math/Point2D.hpp>
+#include <math/Vector2D.hpp>
+#include <math/Transform2D.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const COUNT  = 1000000;
+int const FRAMES = 20;
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+double random_coord() {
+	return rand() / ( RAND_MAX + 1.0 ) * 200.0 - 100.0;
+}
+
+template< class Tp >
+bool close( Tp a, Tp b, Tp tol ) {
+	return fabs( a - b ) <= tol * ( 1 + fabs( a ) + fabs( b ) );
+}
+
+template< class Tp >
+bool close( XYPair< Tp > const & a, XYPair< Tp > const & b, Tp tol ) {
+	return close( a.x, b.x, tol ) && close( a.y, b.y, tol );
+}
+
+/*
+ *  组合后的变换与逐步手工计算一致，逆变换能还原
+ */
+template< class Tp >
+bool test_compose( Tp tol ) {
+	typedef Point2D< Tp > Pt;
+	typedef Vector2D< Tp > Vec;
+	bool ok = true;
+	Tp const angle = (Tp)0.7, sx = (Tp)2.5, sy = (Tp)-0.5;
+	Vec const shift( (Tp)3, (Tp)-4 );
+	Transform2D< Tp > m;
+	m.rotate( angle ).scale( sx, sy ).translate( shift );
+	ok = ok && close( m.determinant(), sx * sy, tol );
+	ok = ok && close( ( Transform2D< Tp >::translation( shift ) * Transform2D< Tp >::scaling( sx, sy ) * Transform2D< Tp >::rotation( angle ) ).a, m.a, tol );
+
+	Transform2D< Tp > inv = m.inverse();
+	for( int i=0; i<1000; ++i ) {
+		Pt p( (Tp)random_coord(), (Tp)random_coord() );
+		Vec v( p.x, p.y );
+		// 手工：旋转、缩放、平移
+		Vec r( v );
+		r.rotate( angle );
+		Pt expect( r.x * sx + shift.x, r.y * sy + shift.y );
+		ok = ok && close( m( p ), expect, tol ) && close( inv( m( p ) ), p, tol );
+		ok = ok && close( m( v ), Vec( r.x * sx, r.y * sy ), tol );
+	}
+	return ok;
+}
+
+/*
+ *  批量版本与逐个 apply 逐位一致，包括不足一个寄存器的尾部
+ */
+template< class Tp >
+bool test_bulk() {
+	typedef Point2D< Tp > Pt;
+	typedef Vector2D< Tp > Vec;
+	bool ok = true;
+	Transform2D< Tp > m = Transform2D< Tp >::rotation( (Tp)1.1 );
+	m.scale( (Tp)1.5 ).translate( (Tp)7, (Tp)-2 );
+	for( int n=0; n<20; ++n ) {
+		vector< Pt > pts( n + 1 ), pts_out( n + 1 );
+		vector< Vec > vecs( n + 1 ), vecs_out( n + 1 );
+		for( int i=0; i<=n; ++i ) {
+			pts[i] = Pt( (Tp)random_coord(), (Tp)random_coord() );
+			vecs[i] = Vec( pts[i].x, pts[i].y );
+		}
+		m.apply( &pts_out[0], &pts[0], n );
+		m.apply( &vecs_out[0], &vecs[0], n );
+		for( int i=0; i<n; ++i ) {
+			ok = ok && pts_out[i].eql( m( pts[i] ) ) && vecs_out[i].eql( m( vecs[i] ) );
+		}
+		// 不越界写
+		ok = ok && pts_out[n].eql( 0, 0 ) && vecs_out[n].eql( 0, 0 );
+		// 原地变换
+		m.apply( &pts[0], &pts[0], n );
+		for( int i=0; i<n; ++i ) {
+			ok = ok && pts[i].eql( pts_out[i] );
+		}
+	}
+	return ok;
+}
+
+/*
+ *  每帧：逐点 rotate(angle) 再缩放平移，对比组合后的一次批量变换
+ */
+template< class Tp >
+void bench( char const * name ) {
+	typedef Point2D< Tp > Pt;
+	typedef Vector2D< Tp > Vec;
+	vector< Pt > pts( COUNT ), out( COUNT );
+	for( int i=0; i<COUNT; ++i ) {
+		pts[i] = Pt( (Tp)random_coord(), (Tp)random_coord() );
+	}
+
+	Tp checksum = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int f=0; f<FRAMES; ++f ) {
+		Tp angle = (Tp)( 0.01 * f ), k = (Tp)( 1 + 0.001 * f );
+		for( int i=0; i<COUNT; ++i ) {
+			Vec v( pts[i].x, pts[i].y );
+			v.rotate( angle );
+			out[i] = Pt( v.x * k + 5, v.y * k - 3 );
+		}
+		checksum += out[f].x;
+	}
+	double manual_ms = elapsed( start );
+
+	start = chrono::steady_clock::now();
+	for( int f=0; f<FRAMES; ++f ) {
+		Tp angle = (Tp)( 0.01 * f ), k = (Tp)( 1 + 0.001 * f );
+		Transform2D< Tp > m = Transform2D< Tp >::rotation( angle );
+		m.scale( k ).translate( 5, -3 );
+		m.apply( &out[0], &pts[0], COUNT );
+		checksum -= out[f].x;
+	}
+	double batch_ms = elapsed( start );
+
+	cout << name << ": per-point rotate/scale/translate " << manual_ms / FRAMES << " ms/frame, Transform2D batch " << batch_ms / FRAMES << " ms/frame (checksum diff " << checksum << ")\n";
+}
+
+void test_Transform2D() {
+	bool ok = test_compose< float >( 1e-4f ) && test_compose< double >( 1e-12 );
+	ok = test_bulk< float >() && ok;
+	ok = test_bulk< double >() && ok;
+
+	cout << COUNT << " points per frame\n";
+	bench< float >( "float " );
+	bench< double >( "double" );
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_Transform2D();
+	return 0;
+}
@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <math/XYPair.hpp>
+#include <math/Vector2DBulk.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const COUNT  = 1 << 16;
+int const ROUNDS = 200;
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+template< class Tp >
+bool same( Tp const * lhs, Tp const * rhs, int n ) {
+	for( int i=0; i<n; ++i ) {
+		if ( lhs[i] != rhs[i] ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ *  与标量版本比较每种运算在所有尾部长度下的结果，并比较 1 个向量到 COUNT 个向量的耗时
+ */
+template< class Tp >
+bool test_type( char const * name ) {
+	typedef XYPair< Tp > Vec;
+
+	vector< Vec > a( COUNT ), b( COUNT ), dst( COUNT ), ref( COUNT );
+	vector< Tp > out( COUNT ), out_ref( COUNT );
+	for( int i=0; i<COUNT; ++i ) {
+		a[i] = Vec( Tp( rand() % 2001 - 1000 ) / 7, Tp( rand() % 2001 - 1000 ) / 3 + 1 );
+		b[i] = Vec( Tp( rand() % 2001 - 1000 ) / 5, Tp( rand() % 2001 - 1000 ) / 9 );
+	}
+	Tp * ac = (Tp *)&a[0];
+	Tp * bc = (Tp *)&b[0];
+	Tp * rc = (Tp *)&ref[0];
+	Tp * dc = (Tp *)&dst[0];
+	Tp const s = std::sin( Tp( 0.3 ) ), c = std::cos( Tp( 0.3 ) );
+
+	bool ok = true;
+	for( int n=0; n<=19; ++n ) {
+		vec2_add( &dst[0], &a[0], &b[0], n );
+		detail::vec2_add_scalar( rc, ac, bc, n );
+		ok = ok && same( dc, rc, 2*n );
+
+		vec2_scale( &dst[0], &a[0], Tp( 1.5 ), n );
+		detail::vec2_scale_scalar( rc, ac, Tp( 1.5 ), n );
+		ok = ok && same( dc, rc, 2*n );
+
+		vec2_dot( &out[0], &a[0], &b[0], n );
+		detail::vec2_dot_scalar( &out_ref[0], ac, bc, n );
+		ok = ok && same( &out[0], &out_ref[0], n );
+
+		vec2_cross( &out[0], &a[0], &b[0], n );
+		detail::vec2_cross_scalar( &out_ref[0], ac, bc, n );
+		ok = ok && same( &out[0], &out_ref[0], n );
+
+		vec2_magnitude( &out[0], &a[0], n );
+		detail::vec2_magnitude_scalar( &out_ref[0], ac, n );
+		ok = ok && same( &out[0], &out_ref[0], n );
+
+		vec2_normalize( &dst[0], &a[0], n );
+		detail::vec2_normalize_scalar( rc, ac, n );
+		ok = ok && same( dc, rc, 2*n );
+
+		vec2_rotate( &dst[0], &a[0], Tp( 0.3 ), n );
+		detail::vec2_rotate_scalar( rc, ac, s, c, n );
+		ok = ok && same( dc, rc, 2*n );
+
+#ifdef BR_HAS_X86_SIMD
+		// SSE2 版本在支持 AVX2 的机器上不会被分派到，单独检查
+		detail::vec2_dot_sse2( &out[0], ac, bc, n );
+		detail::vec2_dot_scalar( &out_ref[0], ac, bc, n );
+		ok = ok && same( &out[0], &out_ref[0], n );
+		detail::vec2_cross_sse2( &out[0], ac, bc, n );
+		detail::vec2_cross_scalar( &out_ref[0], ac, bc, n );
+		ok = ok && same( &out[0], &out_ref[0], n );
+		detail::vec2_normalize_sse2( dc, ac, n );
+		detail::vec2_normalize_scalar( rc, ac, n );
+		ok = ok && same( dc, rc, 2*n );
+		detail::vec2_rotate_sse2( dc, ac, s, c, n );
+		detail::vec2_rotate_scalar( rc, ac, s, c, n );
+		ok = ok && same( dc, rc, 2*n );
+#endif // BR_HAS_X86_SIMD
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		vec2_dot( &out[0], &a[0], &b[0], COUNT );
+		vec2_normalize( &dst[0], &a[0], COUNT );
+		vec2_rotate( &dst[0], &dst[0], Tp( 0.3 ), COUNT );
+	}
+	double bulk_ms = elapsed( start );
+
+	start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		detail::vec2_dot_scalar( &out_ref[0], ac, bc, COUNT );
+		detail::vec2_normalize_scalar( rc, ac, COUNT );
+		detail::vec2_rotate_scalar( rc, rc, s, c, COUNT );
+	}
+	double scalar_ms = elapsed( start );
+	ok = ok && same( &out[0], &out_ref[0], COUNT ) && same( dc, rc, 2*COUNT );
+
+	cout << name << " dot+normalize+rotate: bulk " << bulk_ms << " ms, scalar " << scalar_ms << " ms\n";
+	return ok;
+}
+
+void test_Vector2DBulk() {
+	bool ok = test_type< float >( "float" );
+	ok = test_type< double >( "double" ) && ok;
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_Vector2DBulk();
+	return 0;
+}
@@ -0,0 +1,168 @@
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <new>
+#include <vector>
+
+#include <math/XYPair.hpp>
+#include <structure/BulkPOD.hpp>
+#include <structure/XYArray.hpp>
+
+using namespace std;
+using namespace BR;
+
+int const COUNT  = 1 << 20;
+int const ROUNDS = 100;
+
+/*
+ *  检查每次释放给出的字节数与分配时一致；armed 时第 fail_at 次 reallocate 抛出 bad_alloc
+ */
+struct CheckedAlloc {
+	static map< void *, size_t > live;
+	static int reallocs;
+	static int fail_at;
+	static bool mismatch;
+
+	void * allocate( size_t bytes ) {
+		void * mem = HeapRawAlloc().allocate( bytes );
+		live[mem] = bytes;
+		return mem;
+	}
+
+	void deallocate( void * mem, size_t bytes ) {
+		mismatch = mismatch || live[mem] != bytes;
+		live.erase( mem );
+		HeapRawAlloc().deallocate( mem, bytes );
+	}
+
+	void * reallocate( void * mem, size_t old_bytes, size_t new_bytes, size_t used_bytes ) {
+		if ( ++reallocs == fail_at ) {
+			throw bad_alloc();
+		}
+		mismatch = mismatch || live[mem] != old_bytes;
+		live.erase( mem );
+		void * new_mem = HeapRawAlloc().reallocate( mem, old_bytes, new_bytes, used_bytes );
+		live[new_mem] = new_bytes;
+		return new_mem;
+	}
+};
+
+map< void *, size_t > CheckedAlloc::live;
+int CheckedAlloc::reallocs = 0;
+int CheckedAlloc::fail_at = -1;
+bool CheckedAlloc::mismatch = false;
+
+/*
+ *  y 分量扩容失败时，x 分量回到原容量，内容与析构时的字节数都不受影响
+ */
+bool check_realloc_failure() {
+	bool ok = true;
+	{
+		XYArray< int, CheckedAlloc > pts;
+		for( int i=0; i<100; ++i ) {
+			pts.push_back( i, -i );
+		}
+		int cap = pts.capacity();
+		while ( pts.size() < cap ) {
+			pts.push_back( pts.size(), -pts.size() );
+		}
+		CheckedAlloc::fail_at = CheckedAlloc::reallocs + 2;
+		try {
+			pts.push_back( 0, 0 );
+			ok = false;
+		} catch( bad_alloc const & ) {
+		}
+		ok = ok && pts.capacity() == cap && pts.size() == cap;
+		for( int i=0; i<cap; ++i ) {
+			ok = ok && pts[i].x == i && pts[i].y == -i;
+		}
+	}
+	return ok && !CheckedAlloc::mismatch && CheckedAlloc::live.empty();
+}
+
+double elapsed( chrono::steady_clock::time_point start ) {
+	return chrono::duration< double, milli >( chrono::steady_clock::now() - start ).count();
+}
+
+void test_XYArray() {
+	bool ok = true;
+	float const dt = 0.5f;
+
+	// AoS 对照组
+	vector< XYPair< float > > aos_pos( COUNT ), aos_vel( COUNT );
+	XYArray< float > pos, vel;
+	for( int i=0; i<COUNT; ++i ) {
+		aos_pos[i] = XYPair< float >( i, -i );
+		aos_vel[i] = XYPair< float >( 1, 2 );
+		pos.push_back( XYPair< float >( i, -i ) );
+		vel.push_back( 1.0f, 2.0f );
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		for( int i=0; i<COUNT; ++i ) {
+			aos_pos[i].x += aos_vel[i].x * dt;
+			aos_pos[i].y += aos_vel[i].y * dt;
+		}
+	}
+	double aos_ms = elapsed( start );
+
+	start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		pos.add_scaled( vel, dt );
+	}
+	double soa_ms = elapsed( start );
+	// 两个分量都要读写，AoS 与 SoA 访问的字节数相同，这里不期望有差别
+	cout << "pos += vel * dt: AoS " << aos_ms << " ms, XYArray " << soa_ms << " ms\n";
+
+	for( int i=0; i<COUNT; i+=4097 ) {
+		ok = ok && pos[i].x == aos_pos[i].x && pos[i].y == aos_pos[i].y;
+	}
+
+	// 分量数组可直接交给批量算法
+	ok = ok && bulk_max( pos.xs(), pos.size() ) == COUNT - 1 + ROUNDS * dt;
+
+	// 只用 x 分量：沿 x 平移并求 x 的最大值，SoA 只需读写一半的内存
+	float aos_max = 0, soa_max = 0;
+	start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		float m = aos_pos[0].x;
+		for( int i=0; i<COUNT; ++i ) {
+			aos_pos[i].x += dt;
+			m = aos_pos[i].x > m ? aos_pos[i].x : m;
+		}
+		aos_max += m;
+	}
+	aos_ms = elapsed( start );
+
+	start = chrono::steady_clock::now();
+	for( int r=0; r<ROUNDS; ++r ) {
+		bulk_add( pos.xs(), pos.size(), dt );
+		soa_max += bulk_max( pos.xs(), pos.size() );
+	}
+	soa_ms = elapsed( start );
+	cout << "x += dx, max x: AoS " << aos_ms << " ms, XYArray " << soa_ms << " ms\n";
+	ok = ok && aos_max == soa_max && pos[COUNT-1].x == aos_pos[COUNT-1].x && pos[COUNT-1].y == aos_pos[COUNT-1].y;
+
+	// 代理引用读写
+	XYArray< int > pts;
+	pts.push_back( 1, 2 );
+	pts.push_back( XYPair< int >( 3, 4 ) );
+	pts[0].x += 10;
+	pts[1] = XYPair< int >( 5, 6 );
+	pts[0] = pts[1];
+	XYPair< int > p = pts[1];
+	XYArray< int > const & cpts = pts;
+	ok = ok && p.x == 5 && p.y == 6 && cpts[0].x == 5 && pts.xs()[1] == 5 && pts.ys()[0] == 6;
+	pts.translate( 1, -1 );
+	ok = ok && pts.pop_back().eql( 6, 5 ) && pts.size() == 1;
+
+	ok = check_realloc_failure() && ok;
+
+	cout << ( ok ? "pass" : "FAIL" ) << "\n";
+}
+
+int main() {
+	test_XYArray();
+	return 0;
+}